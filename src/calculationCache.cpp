@@ -0,0 +1,142 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  calculationCache.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Bounded least-recently-used cache of parabola calculation results.
+
+// Local headers
+#include "calculationCache.h"
+#include "facetedResponseCalculator.h"
+#include "deviationCalculator.h"
+
+bool CalculationCache::Request::operator==(const Request& r) const
+{
+	return info.diameter == r.info.diameter &&
+		info.focusPosition == r.info.focusPosition &&
+		info.facetCount == r.info.facetCount &&
+		shapePointCount == r.shapePointCount &&
+		maxFrequency == r.maxFrequency &&
+		responseTolerance == r.responseTolerance;
+}
+
+std::size_t CalculationCache::RequestHash::operator()(const Request& r) const
+{
+	std::size_t seed(0);
+	auto combine([&seed](const std::size_t& h)
+	{
+		seed ^= h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+	});
+
+	combine(std::hash<double>()(r.info.diameter));
+	combine(std::hash<double>()(r.info.focusPosition));
+	combine(std::hash<unsigned int>()(r.info.facetCount));
+	combine(std::hash<unsigned int>()(r.shapePointCount));
+	combine(std::hash<double>()(r.maxFrequency));
+	combine(std::hash<double>()(r.responseTolerance));
+	return seed;
+}
+
+std::shared_ptr<const CalculationCache::Results> CalculationCache::Get(const Request& request, const CancelCheck& isCancelled)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		const auto it(index.find(request));
+		if (it != index.end())
+		{
+			++hitCount;
+			entries.splice(entries.begin(), entries, it->second);
+			return it->second->second;
+		}
+		++missCount;
+	}
+
+	// Compute without holding the lock so other lookups are not blocked
+	auto results(Compute(request, isCancelled));
+	if (!results)
+		return results;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (index.find(request) == index.end())// Another thread may have added it while we were computing
+	{
+		entries.emplace_front(request, results);
+		index[request] = entries.begin();
+		if (entries.size() > capacity)
+		{
+			index.erase(entries.back().first);
+			entries.pop_back();
+		}
+	}
+
+	return results;
+}
+
+void CalculationCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+	index.clear();
+}
+
+unsigned long long CalculationCache::GetHitCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return hitCount;
+}
+
+unsigned long long CalculationCache::GetMissCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return missCount;
+}
+
+std::shared_ptr<const CalculationCache::Results> CalculationCache::Compute(const Request& request, const CancelCheck& isCancelled)
+{
+	auto cancelled([&isCancelled]()
+	{
+		return isCancelled && isCancelled();
+	});
+
+	const ParabolaCalculator calculator(request.info);
+
+	auto results(std::make_shared<Results>());
+	results->depth = calculator.GetParabolaDepth();
+	results->maxDesignError = calculator.GetMaxDesignError();
+
+	DeviationCalculator::Statistics axialDeviation, normalDeviation;
+	if (!DeviationCalculator(request.info).ComputeStatistics(1000, 1000, 0.0, axialDeviation, normalDeviation, cancelled))
+		return nullptr;
+	results->rmsSurfaceError = normalDeviation.rms;
+
+	const unsigned int pointCount(request.shapePointCount);
+	results->parabolaShape.x.resize(pointCount);
+	results->parabolaShape.y.resize(pointCount);
+	calculator.GetParabolaShape(pointCount, results->parabolaShape.x.data(), results->parabolaShape.y.data());
+
+	results->facetShape.x.resize(pointCount);
+	results->facetShape.y.resize(pointCount);
+	calculator.GetFacetShape(pointCount, results->facetShape.x.data(), results->facetShape.y.data());
+
+	if (cancelled())
+		return nullptr;
+
+	calculator.GetAdaptiveResponse(request.maxFrequency, request.responseTolerance, results->response.x, results->response.y);
+	if (cancelled())
+		return nullptr;
+
+	// Built dish response at the same frequencies, so the two curves can be compared point for point
+	results->builtResponse.x = results->response.x;
+	results->builtResponse.y.resize(results->builtResponse.x.size());
+	if (!FacetedResponseCalculator(request.info).ComputeResponse(results->builtResponse.x.data(),
+		results->builtResponse.y.data(), static_cast<unsigned int>(results->builtResponse.x.size()), cancelled))
+		return nullptr;
+
+	return results;
+}
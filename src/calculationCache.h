@@ -0,0 +1,98 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  calculationCache.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Bounded least-recently-used cache of parabola calculation results.
+
+#ifndef CALCULATION_CACHE_H_
+#define CALCULATION_CACHE_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+
+// Standard C++ headers
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <cstddef>
+
+class CalculationCache
+{
+public:
+	explicit CalculationCache(const std::size_t& _capacity = 32) : capacity(_capacity) {}
+
+	// Everything that affects the results is part of the key
+	struct Request
+	{
+		ParabolaCalculator::ParabolaInfo info;
+		unsigned int shapePointCount = 500;
+		double maxFrequency = 20000.0;// [Hz]
+		double responseTolerance = 0.05;// [dB]
+
+		bool operator==(const Request& r) const;
+	};
+
+	// Curves are stored as separate x and y arrays so they can be copied to plot datasets in bulk
+	struct Curve
+	{
+		std::vector<double> x;
+		std::vector<double> y;
+	};
+
+	struct Results
+	{
+		double depth;// [in]
+		double maxDesignError;// [in]
+		double rmsSurfaceError;// [in] normal to the surface, over the whole dish
+
+		Curve parabolaShape;// [in]
+		Curve facetShape;// [in]
+		Curve response;// [Hz], [dB]
+		Curve builtResponse;// [Hz], [dB] for the dish as assembled from flat facets
+	};
+
+	// Polled between calculation steps and within the long ones (possibly from several threads at once); returning true
+	// abandons the calculation
+	typedef std::function<bool()> CancelCheck;
+
+	// Returns cached results if available, otherwise computes (and caches) them.  Safe to call from any thread.
+	// Returns nullptr (and caches nothing) if the calculation was cancelled.
+	std::shared_ptr<const Results> Get(const Request& request, const CancelCheck& isCancelled = CancelCheck());
+
+	void Clear();
+
+	unsigned long long GetHitCount() const;
+	unsigned long long GetMissCount() const;
+
+private:
+	const std::size_t capacity;
+
+	struct RequestHash
+	{
+		std::size_t operator()(const Request& r) const;
+	};
+
+	typedef std::pair<Request, std::shared_ptr<const Results>> Entry;
+	std::list<Entry> entries;// Most recently used at the front
+	std::unordered_map<Request, std::list<Entry>::iterator, RequestHash> index;
+
+	unsigned long long hitCount = 0;
+	unsigned long long missCount = 0;
+
+	mutable std::mutex mutex;
+
+	static std::shared_ptr<const Results> Compute(const Request& request, const CancelCheck& isCancelled);
+};
+
+#endif// CALCULATION_CACHE_H_
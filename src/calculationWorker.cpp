@@ -0,0 +1,78 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  calculationWorker.cpp
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Background thread for updating the calculation results.  Only the most recent request matters, so each new
+//        request replaces any that hasn't started and cancels the one in progress.
+
+// Local headers
+#include "calculationWorker.h"
+
+CalculationWorker::CalculationWorker(CalculationCache& cache, ResultsCallback onResults) : cache(cache), onResults(onResults)
+{
+	thread = std::thread(&CalculationWorker::ThreadEntry, this);
+}
+
+CalculationWorker::~CalculationWorker()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	requestReadyCondition.notify_one();
+	thread.join();
+}
+
+unsigned long long CalculationWorker::Submit(const CalculationCache::Request& request)
+{
+	unsigned long long requestId;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pendingRequest = request;
+		requestPending = true;
+		requestId = ++latestRequestId;// Also tells the calculation in progress (if any) to give up
+	}
+
+	requestReadyCondition.notify_one();
+	return requestId;
+}
+
+void CalculationWorker::ThreadEntry()
+{
+	while (true)
+	{
+		CalculationCache::Request request;
+		unsigned long long requestId;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			requestReadyCondition.wait(lock, [this]()
+			{
+				return requestPending || stopping;
+			});
+
+			if (stopping)
+				return;
+
+			request = pendingRequest;
+			requestId = latestRequestId;
+			requestPending = false;
+		}
+
+		const auto results(cache.Get(request, [this, &requestId]()
+		{
+			return stopping || !IsLatest(requestId);
+		}));
+
+		if (results && !stopping && IsLatest(requestId))
+			onResults(results, requestId);
+	}
+}
@@ -0,0 +1,61 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  calculationWorker.h
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Background thread for updating the calculation results.  Only the most recent request matters, so each new
+//        request replaces any that hasn't started and cancels the one in progress.
+
+#ifndef CALCULATION_WORKER_H_
+#define CALCULATION_WORKER_H_
+
+// Local headers
+#include "calculationCache.h"
+
+// Standard C++ headers
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+class CalculationWorker
+{
+public:
+	// Called on the worker thread; the receiver is responsible for getting back to its own thread
+	typedef std::function<void(const std::shared_ptr<const CalculationCache::Results>& results, const unsigned long long& requestId)> ResultsCallback;
+
+	CalculationWorker(CalculationCache& cache, ResultsCallback onResults);
+	~CalculationWorker();
+
+	// Returns an ID for matching the results to the request
+	unsigned long long Submit(const CalculationCache::Request& request);
+
+	// True if no newer request has been submitted, for discarding results that arrive late
+	inline bool IsLatest(const unsigned long long& requestId) const { return requestId == latestRequestId; }
+
+private:
+	CalculationCache& cache;
+	const ResultsCallback onResults;
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable requestReadyCondition;
+
+	CalculationCache::Request pendingRequest;
+	bool requestPending = false;
+	std::atomic<bool> stopping = false;
+	std::atomic<unsigned long long> latestRequestId = 0;
+
+	void ThreadEntry();
+};
+
+#endif// CALCULATION_WORKER_H_
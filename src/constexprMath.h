@@ -0,0 +1,135 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  constexprMath.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Math functions usable in constant expressions.
+
+#ifndef CONSTEXPR_MATH_H_
+#define CONSTEXPR_MATH_H_
+
+// Standard C++ headers
+#include <cmath>
+#include <limits>
+
+// When the compiler can tell us whether we're being evaluated at compile time, the runtime path
+// uses the standard library.  Otherwise the constexpr implementations are used everywhere.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define CONSTEXPR_MATH_HAS_IS_CONSTANT_EVALUATED
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define CONSTEXPR_MATH_HAS_IS_CONSTANT_EVALUATED
+#endif
+
+namespace ConstexprMath
+{
+
+constexpr bool IsConstantEvaluated()
+{
+#ifdef CONSTEXPR_MATH_HAS_IS_CONSTANT_EVALUATED
+	return __builtin_is_constant_evaluated();
+#else
+	return true;
+#endif
+}
+
+namespace Detail
+{
+
+// Newton's method after scaling x into [1, 4) by powers of four
+constexpr double Sqrt(double x)
+{
+	if (x < 0.0)
+		return std::numeric_limits<double>::quiet_NaN();
+	if (x == 0.0 || x == std::numeric_limits<double>::infinity())
+		return x;
+
+	double scale(1.0);
+	while (x >= 4.0)
+	{
+		x *= 0.25;
+		scale *= 2.0;
+	}
+	while (x < 1.0)
+	{
+		x *= 4.0;
+		scale *= 0.5;
+	}
+
+	double y(0.5 * (1.0 + x));
+	for (unsigned int i = 0; i < 10; ++i)
+		y = 0.5 * (y + x / y);
+
+	return y * scale;
+}
+
+// Splits x = m * 2^e with m in [sqrt(0.5), sqrt(2)), then log(m) = 2 * atanh((m - 1) / (m + 1))
+constexpr double Log(double x)
+{
+	if (x < 0.0)
+		return std::numeric_limits<double>::quiet_NaN();
+	if (x == 0.0)
+		return -std::numeric_limits<double>::infinity();
+	if (x == std::numeric_limits<double>::infinity())
+		return x;
+
+	int exponent(0);
+	while (x >= M_SQRT2)
+	{
+		x *= 0.5;
+		++exponent;
+	}
+	while (x < M_SQRT1_2)
+	{
+		x *= 2.0;
+		--exponent;
+	}
+
+	const double s((x - 1.0) / (x + 1.0));
+	const double s2(s * s);
+	double term(s);
+	double sum(0.0);
+	for (unsigned int k = 1; k < 60; k += 2)
+	{
+		const double next(sum + term / k);
+		if (next == sum)
+			break;
+		sum = next;
+		term *= s2;
+	}
+
+	return 2.0 * sum + exponent * M_LN2;
+}
+
+}// namespace Detail
+
+constexpr double Sqrt(const double& x)
+{
+	if (IsConstantEvaluated())
+		return Detail::Sqrt(x);
+	return std::sqrt(x);
+}
+
+constexpr double Log(const double& x)
+{
+	if (IsConstantEvaluated())
+		return Detail::Log(x);
+	return std::log(x);
+}
+
+constexpr double Abs(const double& x)
+{
+	return x < 0.0 ? -x : x;
+}
+
+}// namespace ConstexprMath
+
+#endif// CONSTEXPR_MATH_H_
@@ -0,0 +1,180 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  cutPathGenerator.cpp
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Base class for files that drive cutting machines (laser, drag knife).  Unlike the printable templates, each
+//        outline is written whole, as a closed path in [mm], optionally offset to make up for the cut's width.
+
+// Local headers
+#include "cutPathGenerator.h"
+#include "goreNester.h"
+
+// Standard C++ headers
+#include <fstream>
+
+const double CutPathGenerator::miterLimit(4.0);
+
+// The outline is moved so its compensated path starts at zero, like the nested layouts (gores are centered on the x-axis)
+bool CutPathGenerator::WriteOutline(const Vector2DVectors& shape, const std::string& fileName)
+{
+	if (shape.empty())
+		return false;
+
+	Eigen::Vector2d minimum(shape.front());
+	for (const auto& p : shape)
+		minimum = minimum.cwiseMin(p);
+
+	const Eigen::Vector2d shift(Eigen::Vector2d::Constant(GetReach()) - minimum);
+	Vector2DVectors shifted(shape);
+	for (auto& p : shifted)
+		p += shift;
+
+	return WriteSheets(std::vector<std::vector<Vector2DVectors>>(1, std::vector<Vector2DVectors>(1, shifted)), fileName);
+}
+
+bool CutPathGenerator::WriteNestedOutlines(const Vector2DVectors& shape, const unsigned int& copies, const std::string& fileName)
+{
+	// Neighbors are spaced from the uncompensated outlines, so the kerf is added to keep the full gap between cuts
+	const GoreNester nester(shape, nestingGap * 25.4 + kerf);
+
+	const double reach(GetReach());// [mm]
+	std::vector<std::vector<Vector2DVectors>> sheets;
+	if (sheetWidth > 0.0 && sheetHeight > 0.0)
+		sheets = nester.NestOnSheets(copies, sheetWidth * 25.4 - 2.0 * reach, sheetHeight * 25.4 - 2.0 * reach);
+	else
+	{
+		sheets.push_back(nester.NestForFewestSheets(copies, [](const double&, const double&)
+		{
+			return 1U;// Everything is cut at once, so only the area matters
+		}));
+	}
+
+	if (sheets.empty() || sheets.front().empty())
+		return false;
+
+	// Keeps the compensated paths from going below zero
+	for (auto& sheet : sheets)
+	{
+		for (auto& outline : sheet)
+		{
+			for (auto& p : outline)
+				p += Eigen::Vector2d::Constant(reach);
+		}
+	}
+
+	return WriteSheets(sheets, fileName);
+}
+
+// Farthest the compensated path can be from the outline (at a corner cut off at the miter limit)
+double CutPathGenerator::GetReach() const
+{
+	return 0.5 * kerf * miterLimit;
+}
+
+// Each outline is written to the file as soon as it's formatted, with the buffer reused
+bool CutPathGenerator::WriteSheets(const std::vector<std::vector<Vector2DVectors>>& sheets, const std::string& fileName)
+{
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	unsigned int pathCount(0);
+	for (const auto& sheet : sheets)
+		pathCount += static_cast<unsigned int>(sheet.size());
+
+	OutputBuffer buffer(precision);
+	WriteHeader(static_cast<unsigned int>(sheets.size()), pathCount, buffer);
+	for (unsigned int i = 0; i < sheets.size(); ++i)
+	{
+		BeginSheet(i, buffer);
+		for (const auto& outline : sheets[i])
+		{
+			const auto cleaned(RemoveRepeatedPoints(outline));
+			if (cleaned.size() < 2)
+				continue;
+
+			WritePath(kerf > 0.0 ? OffsetOutline(cleaned, 0.5 * kerf) : cleaned, i, buffer);
+			file << buffer;
+			buffer.Clear();
+		}
+	}
+
+	WriteFooter(buffer);
+	file << buffer;
+	return file.good();
+}
+
+// Also drops the closing point, if the outline repeats its first point at the end
+CutPathGenerator::Vector2DVectors CutPathGenerator::RemoveRepeatedPoints(const Vector2DVectors& outline)
+{
+	Vector2DVectors cleaned;
+	cleaned.reserve(outline.size());
+	for (const auto& p : outline)
+	{
+		if (cleaned.empty() || p != cleaned.back())
+			cleaned.push_back(p);
+	}
+
+	while (cleaned.size() > 1 && cleaned.front() == cleaned.back())
+		cleaned.pop_back();
+
+	return cleaned;
+}
+
+// Moves each edge outward by distance and joins neighbors where they meet (a miter).  At sharp convex corners the miter
+// would reach far past the outline, so it's cut off square at miterLimit times the distance, which still keeps the
+// whole path at least the distance away.  Concave corners always use the miter, which is where the offset edges cross.
+CutPathGenerator::Vector2DVectors CutPathGenerator::OffsetOutline(const Vector2DVectors& outline, const double& distance)
+{
+	const unsigned int n(outline.size());
+	double twiceArea(0.0);
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		const Eigen::Vector2d& p1(outline[i]);
+		const Eigen::Vector2d& p2(outline[(i + 1) % n]);
+		twiceArea += p1(0) * p2(1) - p2(0) * p1(1);
+	}
+
+	// Outward is to the right when walking counter-clockwise
+	const double side(twiceArea > 0.0 ? 1.0 : -1.0);
+	auto getNormal([&side](const Eigen::Vector2d& direction)
+	{
+		return Eigen::Vector2d(side * direction(1), -side * direction(0));
+	});
+
+	Vector2DVectors offset;
+	offset.reserve(n + n / 4);
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		const Eigen::Vector2d& p(outline[i]);
+		const Eigen::Vector2d incoming((p - outline[(i + n - 1) % n]).normalized());
+		const Eigen::Vector2d outgoing((outline[(i + 1) % n] - p).normalized());
+		const Eigen::Vector2d normal1(getNormal(incoming));
+		const Eigen::Vector2d normal2(getNormal(outgoing));
+
+		const double cosine(normal1.dot(normal2));
+		const bool spike(1.0 + cosine < 1.0e-12);// Outline doubles back on itself
+		const bool convex(side * (incoming(0) * outgoing(1) - incoming(1) * outgoing(0)) > 0.0);
+		if (!spike && (!convex || (1.0 + cosine) * miterLimit * miterLimit >= 2.0))
+		{
+			offset.push_back(p + distance * (normal1 + normal2) / (1.0 + cosine));
+			continue;
+		}
+
+		// Each offset edge is extended until it reaches the line across the miter at its limit
+		const Eigen::Vector2d bisector(spike ? incoming : Eigen::Vector2d((normal1 + normal2).normalized()));
+		const double reach(miterLimit * distance);
+		offset.push_back(p + distance * normal1 + (reach - distance * normal1.dot(bisector)) / incoming.dot(bisector) * incoming);
+		offset.push_back(p + distance * normal2 + (reach - distance * normal2.dot(bisector)) / outgoing.dot(bisector) * outgoing);
+	}
+
+	return offset;
+}
@@ -0,0 +1,76 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  cutPathGenerator.h
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Base class for files that drive cutting machines (laser, drag knife).  Unlike the printable templates, each
+//        outline is written whole, as a closed path in [mm], optionally offset to make up for the cut's width.
+
+#ifndef CUT_PATH_GENERATOR_H_
+#define CUT_PATH_GENERATOR_H_
+
+// Local headers
+#include "outputBuffer.h"
+
+// Eigen headers
+#include <Eigen/Eigen>
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+
+class CutPathGenerator
+{
+public:
+	typedef std::vector<Eigen::Vector2d, Eigen::aligned_allocator<Eigen::Vector2d>> Vector2DVectors;
+
+	virtual ~CutPathGenerator() = default;
+
+	inline void SetKerf(const double& k) { kerf = k; }// [mm]
+	inline void SetSheetSize(const double& w, const double& h) { sheetWidth = w; sheetHeight = h; }// [in]
+	inline void SetNestingGap(const double& g) { nestingGap = g; }// [in]
+	inline void SetPrecision(const unsigned int& p) { precision = p; }
+
+	// Shape is the closed outline in [mm]
+	bool WriteOutline(const Vector2DVectors& shape, const std::string& fileName);
+
+	// Packs copies of the shape together (see GoreNester); into one layout with the smallest area, or across as few
+	// sheets as possible if a sheet size is set
+	bool WriteNestedOutlines(const Vector2DVectors& shape, const unsigned int& copies, const std::string& fileName);
+
+protected:
+	// Paths are closed outlines, passed without repeating the first point; the format closes them.  The header gets
+	// the number of sheets and an upper bound on the number of paths (outlines that collapse to a point are skipped).
+	virtual void WriteHeader(const unsigned int& sheetCount, const unsigned int& pathCount, OutputBuffer& out) = 0;
+	virtual void BeginSheet(const unsigned int& sheet, OutputBuffer& out) = 0;
+	virtual void WritePath(const Vector2DVectors& path, const unsigned int& sheet, OutputBuffer& out) = 0;
+	virtual void WriteFooter(OutputBuffer& out) = 0;
+
+	double kerf = 0.0;// [mm] width of material removed by the cut; outlines are moved out by half of this
+
+	double sheetWidth = 0.0;// [in] zero for no limit
+	double sheetHeight = 0.0;// [in] zero for no limit
+	double nestingGap = 0.125;// [in] between nested copies (in addition to the kerf)
+
+	unsigned int precision = 3;// Digits after the decimal point (0.001 mm)
+
+private:
+	static const double miterLimit;// Longest corner extension of the compensated path, as a multiple of the offset
+
+	double GetReach() const;// [mm]
+
+	// Each inner vector holds the outlines cut from one sheet
+	bool WriteSheets(const std::vector<std::vector<Vector2DVectors>>& sheets, const std::string& fileName);
+
+	static Vector2DVectors RemoveRepeatedPoints(const Vector2DVectors& outline);
+	static Vector2DVectors OffsetOutline(const Vector2DVectors& outline, const double& distance);
+};
+
+#endif// CUT_PATH_GENERATOR_H_
@@ -0,0 +1,234 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  designSolver.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Finds parabola designs that meet performance targets.
+
+// Local headers
+#include "designSolver.h"
+#include "threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+
+// Radical inverse, used to spread start points over the bounds (Halton sequence)
+double RadicalInverse(unsigned int i, const unsigned int& base)
+{
+	double result(0.0);
+	double fraction(1.0 / base);
+	while (i > 0)
+	{
+		result += (i % base) * fraction;
+		i /= base;
+		fraction /= base;
+	}
+	return result;
+}
+
+}// namespace
+
+std::vector<DesignSolver::Solution> DesignSolver::Solve() const
+{
+	if (bounds.maxFacetCount < bounds.minFacetCount || startCount == 0)
+		return std::vector<Solution>();
+
+	const unsigned int facetCountCount(bounds.maxFacetCount - bounds.minFacetCount + 1);
+	std::vector<Solution> candidates(static_cast<std::size_t>(facetCountCount) * startCount);
+	std::vector<double> violations(candidates.size());
+
+	ThreadPool pool(threadCount);
+	pool.ParallelFor(candidates.size(), [this, &candidates, &violations](const std::size_t& i)
+	{
+		const unsigned int facetCount(bounds.minFacetCount + static_cast<unsigned int>(i / startCount));
+		const unsigned int start(static_cast<unsigned int>(i % startCount));
+		const double diameter(bounds.minDiameter + (bounds.maxDiameter - bounds.minDiameter) * RadicalInverse(start + 1, 2));
+		const double focusPosition(bounds.minFocusPosition + (bounds.maxFocusPosition - bounds.minFocusPosition) * RadicalInverse(start + 1, 3));
+		candidates[i] = LocalSearch(diameter, focusPosition, facetCount, violations[i]);
+	});
+
+	// Keep the best feasible result for each facet count
+	const double feasibilityTolerance(1.0e-6);
+	std::vector<Solution> solutions;
+	for (unsigned int n = 0; n < facetCountCount; ++n)
+	{
+		const Solution* best(nullptr);
+		for (unsigned int s = 0; s < startCount; ++s)
+		{
+			const std::size_t i(static_cast<std::size_t>(n) * startCount + s);
+			if (violations[i] <= feasibilityTolerance && (!best || candidates[i].cost < best->cost))
+				best = &candidates[i];
+		}
+
+		if (best)
+			solutions.push_back(*best);
+	}
+
+	std::sort(solutions.begin(), solutions.end(), [](const Solution& a, const Solution& b)
+	{
+		return a.cost < b.cost;
+	});
+
+	return solutions;
+}
+
+DesignSolver::Evaluation DesignSolver::Evaluate(const double& diameter, const double& focusPosition, const unsigned int& facetCount) const
+{
+	Evaluation e;
+	e.violation = 0.0;
+
+	// Out-of-bounds parameters are clamped for evaluation and counted as violations, which pulls the search back inside
+	ParabolaCalculator::ParabolaInfo info;
+	info.diameter = std::min(std::max(diameter, bounds.minDiameter), bounds.maxDiameter);
+	info.focusPosition = std::min(std::max(focusPosition, bounds.minFocusPosition), bounds.maxFocusPosition);
+	info.facetCount = facetCount;
+	e.violation += fabs(diameter - info.diameter) + fabs(focusPosition - info.focusPosition);
+
+	const ParabolaCalculator calculator(info);
+	const double depth(calculator.GetParabolaDepth());
+	e.violation += std::max(depth - targets.maxDepth, 0.0);
+	e.violation += std::max(calculator.GetMaxDesignError() - targets.maxDesignError, 0.0);
+
+	for (const auto& target : targets.gain)
+	{
+		double gain;
+		calculator.ComputeResponse(&target.frequency, &gain, 1);
+		e.violation += std::max(target.minimumGain - gain, 0.0);
+	}
+
+	if (objective == Objective::Depth)
+		e.cost = depth;
+	else if (objective == Objective::Diameter)
+		e.cost = info.diameter;
+	else// if (objective == Objective::FacetCount)
+		e.cost = facetCount + 1.0e-3 * depth;// Facet count is fixed during each search, so depth breaks ties
+
+	return e;
+}
+
+// Nelder-Mead search over (diameter, focus position) on a penalized cost, repeated with increasing penalty weights.
+// A parameter whose bounds have zero width (e.g. a fixed diameter) is held constant and the search runs over the rest.
+DesignSolver::Solution DesignSolver::LocalSearch(const double& diameter, const double& focusPosition, const unsigned int& facetCount, double& violation) const
+{
+	typedef std::array<double, 2> Point;
+	struct Vertex
+	{
+		Point p;
+		double f;
+	};
+
+	double penaltyWeight;
+	auto penalizedCost([this, &facetCount, &penaltyWeight](const Point& p)
+	{
+		const auto e(Evaluate(p[0], p[1], facetCount));
+		return e.cost + penaltyWeight * (e.violation + e.violation * e.violation);
+	});
+
+	const Point scale = {{ 0.1 * (bounds.maxDiameter - bounds.minDiameter), 0.1 * (bounds.maxFocusPosition - bounds.minFocusPosition) }};
+	Point best = {{ diameter, focusPosition }};
+
+	std::vector<unsigned int> freeParameters;
+	for (unsigned int i = 0; i < scale.size(); ++i)
+	{
+		if (scale[i] > 0.0)
+			freeParameters.push_back(i);
+	}
+
+	for (const double& weight : { 1.0e2, 1.0e4, 1.0e6 })
+	{
+		if (freeParameters.empty())
+			break;
+
+		penaltyWeight = weight;
+		std::vector<Vertex> simplex(freeParameters.size() + 1);
+		simplex[0].p = best;
+		for (unsigned int i = 0; i < freeParameters.size(); ++i)
+		{
+			simplex[i + 1].p = best;
+			simplex[i + 1].p[freeParameters[i]] += scale[freeParameters[i]];
+		}
+
+		for (auto& v : simplex)
+			v.f = penalizedCost(v.p);
+
+		auto combine([](const Point& a, const Point& b, const double& t)
+		{
+			return Point{{ a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1]) }};
+		});
+
+		Vertex& worst(simplex.back());
+		const Vertex& secondWorst(simplex[simplex.size() - 2]);
+		const unsigned int maxIterations(400);
+		for (unsigned int iteration = 0; iteration < maxIterations; ++iteration)
+		{
+			std::sort(simplex.begin(), simplex.end(), [](const Vertex& a, const Vertex& b) { return a.f < b.f; });
+			double size(0.0);
+			for (const auto& i : freeParameters)
+				size = std::max(size, fabs(worst.p[i] - simplex[0].p[i]) / scale[i]);
+			if (size < 1.0e-9)
+				break;
+
+			Point centroid(simplex[0].p);
+			for (unsigned int i = 1; i + 1 < simplex.size(); ++i)
+				centroid = combine(centroid, simplex[i].p, 1.0 / (i + 1.0));// Running mean of all but the worst
+
+			const Point reflected(combine(centroid, worst.p, -1.0));
+			const double fReflected(penalizedCost(reflected));
+			if (fReflected < simplex[0].f)
+			{
+				const Point expanded(combine(centroid, worst.p, -2.0));
+				const double fExpanded(penalizedCost(expanded));
+				if (fExpanded < fReflected)
+					worst = Vertex{ expanded, fExpanded };
+				else
+					worst = Vertex{ reflected, fReflected };
+			}
+			else if (fReflected < secondWorst.f)
+				worst = Vertex{ reflected, fReflected };
+			else
+			{
+				const Point contracted(combine(centroid, worst.p, fReflected < worst.f ? -0.5 : 0.5));
+				const double fContracted(penalizedCost(contracted));
+				if (fContracted < std::min(fReflected, worst.f))
+					worst = Vertex{ contracted, fContracted };
+				else
+				{
+					for (unsigned int i = 1; i < simplex.size(); ++i)
+					{
+						simplex[i].p = combine(simplex[0].p, simplex[i].p, 0.5);
+						simplex[i].f = penalizedCost(simplex[i].p);
+					}
+				}
+			}
+		}
+
+		const auto bestVertex(std::min_element(simplex.begin(), simplex.end(), [](const Vertex& a, const Vertex& b) { return a.f < b.f; }));
+		best = bestVertex->p;
+	}
+
+	const auto e(Evaluate(best[0], best[1], facetCount));
+	violation = e.violation;
+
+	Solution s;
+	s.info.diameter = best[0];
+	s.info.focusPosition = best[1];
+	s.info.facetCount = facetCount;
+
+	const ParabolaCalculator calculator(s.info);
+	s.depth = calculator.GetParabolaDepth();
+	s.maxDesignError = calculator.GetMaxDesignError();
+	s.cost = e.cost;
+	return s;
+}
@@ -0,0 +1,99 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  designSolver.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Finds parabola designs that meet performance targets.
+
+#ifndef DESIGN_SOLVER_H_
+#define DESIGN_SOLVER_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+
+// Standard C++ headers
+#include <vector>
+#include <limits>
+
+class DesignSolver
+{
+public:
+	struct GainTarget
+	{
+		GainTarget() = default;
+		GainTarget(const double& _frequency, const double& _minimumGain) : frequency(_frequency), minimumGain(_minimumGain) {}
+
+		double frequency;// [Hz]
+		double minimumGain;// [dB]
+	};
+
+	struct Targets
+	{
+		std::vector<GainTarget> gain;
+		double maxDesignError = std::numeric_limits<double>::infinity();// [in]
+		double maxDepth = std::numeric_limits<double>::infinity();// [in]
+	};
+
+	struct Bounds
+	{
+		double minDiameter = 6.0;// [in]
+		double maxDiameter = 48.0;// [in]
+		double minFocusPosition = 1.0;// [in]
+		double maxFocusPosition = 24.0;// [in]
+		unsigned int minFacetCount = 3;
+		unsigned int maxFacetCount = 48;
+	};
+
+	enum class Objective
+	{
+		Depth,// Shallowest dish
+		Diameter,// Smallest dish
+		FacetCount// Fewest facets (ties broken by depth)
+	};
+
+	struct Solution
+	{
+		ParabolaCalculator::ParabolaInfo info;
+		double depth;// [in]
+		double maxDesignError;// [in]
+		double cost;
+	};
+
+	void SetTargets(const Targets& t) { targets = t; }
+	void SetBounds(const Bounds& b) { bounds = b; }
+	void SetObjective(const Objective& o) { objective = o; }
+
+	// Number of local searches started from different points for each facet count
+	void SetStartCount(const unsigned int& count) { startCount = count; }
+
+	// Zero threads means "use one thread per core"
+	void SetThreadCount(const unsigned int& count) { threadCount = count; }
+
+	// Returns the best feasible design for each facet count that has one, sorted by increasing cost
+	std::vector<Solution> Solve() const;
+
+private:
+	Targets targets;
+	Bounds bounds;
+	Objective objective = Objective::Depth;
+	unsigned int startCount = 16;
+	unsigned int threadCount = 0;
+
+	struct Evaluation
+	{
+		double cost;
+		double violation;
+	};
+
+	Evaluation Evaluate(const double& diameter, const double& focusPosition, const unsigned int& facetCount) const;
+	Solution LocalSearch(const double& diameter, const double& focusPosition, const unsigned int& facetCount, double& violation) const;
+};
+
+#endif// DESIGN_SOLVER_H_
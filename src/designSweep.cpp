@@ -0,0 +1,91 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  designSweep.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Evaluates a grid of parabola designs in parallel.
+
+// Local headers
+#include "designSweep.h"
+#include "threadPool.h"
+
+double DesignSweep::Range::GetValue(const unsigned int& i) const
+{
+	if (count < 2)
+		return minimum;
+	return minimum + (maximum - minimum) * i / (count - 1);
+}
+
+unsigned int DesignSweep::FacetRange::GetCount() const
+{
+	if (maximum < minimum || step == 0)
+		return 0;
+	return (maximum - minimum) / step + 1;
+}
+
+std::size_t DesignSweep::GetDesignCount() const
+{
+	return static_cast<std::size_t>(diameterRange.count) * focusPositionRange.count * facetRange.GetCount();
+}
+
+ParabolaCalculator::ParabolaInfo DesignSweep::GetDesign(const std::size_t& index) const
+{
+	// Facet count varies fastest, then focus position, then diameter
+	const unsigned int facetCount(facetRange.GetCount());
+	const unsigned int facetIndex(static_cast<unsigned int>(index % facetCount));
+	const unsigned int focusIndex(static_cast<unsigned int>((index / facetCount) % focusPositionRange.count));
+	const unsigned int diameterIndex(static_cast<unsigned int>(index / facetCount / focusPositionRange.count));
+
+	ParabolaCalculator::ParabolaInfo info;
+	info.diameter = diameterRange.GetValue(diameterIndex);
+	info.focusPosition = focusPositionRange.GetValue(focusIndex);
+	info.facetCount = facetRange.minimum + facetIndex * facetRange.step;
+	return info;
+}
+
+DesignSweep::Results DesignSweep::Run() const
+{
+	const std::size_t designCount(GetDesignCount());
+
+	Results results;
+	results.diameter.resize(designCount);
+	results.focusPosition.resize(designCount);
+	results.facetCount.resize(designCount);
+	results.depth.resize(designCount);
+	results.maxDesignError.resize(designCount);
+
+	if (responsePointCount > 0 && designCount > 0)
+	{
+		// Frequencies depend only on the sampling parameters, so they are the same for every design
+		results.frequency = ParabolaCalculator::GetResponseFrequencies(responsePointCount, responseMaxFrequency);
+		results.gain.resize(designCount * responsePointCount);
+	}
+
+	ThreadPool pool(threadCount);
+	pool.ParallelFor(designCount, [this, &results](const std::size_t& i)
+	{
+		// Each design gets its own calculator, so nothing mutable is shared between threads
+		const ParabolaCalculator calculator(GetDesign(i));
+		const auto& info(calculator.GetParabolaInfo());
+
+		results.diameter[i] = info.diameter;
+		results.focusPosition[i] = info.focusPosition;
+		results.facetCount[i] = info.facetCount;
+		results.depth[i] = calculator.GetParabolaDepth();
+		results.maxDesignError[i] = calculator.GetMaxDesignError();
+
+		if (responsePointCount == 0)
+			return;
+
+		calculator.ComputeResponse(results.frequency.data(), results.gain.data() + i * responsePointCount, responsePointCount);
+	});
+
+	return results;
+}
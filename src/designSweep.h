@@ -0,0 +1,95 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  designSweep.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Evaluates a grid of parabola designs in parallel.
+
+#ifndef DESIGN_SWEEP_H_
+#define DESIGN_SWEEP_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+
+// Standard C++ headers
+#include <vector>
+#include <cstddef>
+
+class DesignSweep
+{
+public:
+	struct Range
+	{
+		Range() = default;
+		Range(const double& _minimum, const double& _maximum, const unsigned int& _count) : minimum(_minimum), maximum(_maximum), count(_count) {}
+
+		double minimum = 0.0;
+		double maximum = 0.0;
+		unsigned int count = 1;// Number of evenly spaced values, including both ends
+
+		double GetValue(const unsigned int& i) const;
+	};
+
+	struct FacetRange
+	{
+		FacetRange() = default;
+		FacetRange(const unsigned int& _minimum, const unsigned int& _maximum, const unsigned int& _step = 1) : minimum(_minimum), maximum(_maximum), step(_step) {}
+
+		unsigned int minimum = 3;
+		unsigned int maximum = 3;
+		unsigned int step = 1;
+
+		unsigned int GetCount() const;
+	};
+
+	// Struct-of-arrays table with one entry per design.  Response gains are stored row-major,
+	// with one row of frequency.size() values per design.
+	struct Results
+	{
+		std::vector<double> diameter;// [in]
+		std::vector<double> focusPosition;// [in]
+		std::vector<unsigned int> facetCount;
+		std::vector<double> depth;// [in]
+		std::vector<double> maxDesignError;// [in]
+
+		std::vector<double> frequency;// [Hz] shared by all designs
+		std::vector<double> gain;// [dB]
+
+		std::size_t GetDesignCount() const { return diameter.size(); }
+		const double* GetGainRow(const std::size_t& design) const { return gain.data() + design * frequency.size(); }
+	};
+
+	void SetDiameterRange(const Range& range) { diameterRange = range; }
+	void SetFocusPositionRange(const Range& range) { focusPositionRange = range; }
+	void SetFacetCountRange(const FacetRange& range) { facetRange = range; }
+
+	// Set pointCount to zero to skip the response calculation
+	void SetResponseSampling(const unsigned int& pointCount, const double& maxFrequency) { responsePointCount = pointCount; responseMaxFrequency = maxFrequency; }
+
+	// Zero threads means "use one thread per core"
+	void SetThreadCount(const unsigned int& count) { threadCount = count; }
+
+	std::size_t GetDesignCount() const;
+	Results Run() const;
+
+private:
+	Range diameterRange = Range(24.0, 24.0, 1);
+	Range focusPositionRange = Range(6.0, 6.0, 1);
+	FacetRange facetRange = FacetRange(10, 10);
+
+	unsigned int responsePointCount = 50;
+	double responseMaxFrequency = 20000.0;// [Hz]
+
+	unsigned int threadCount = 0;
+
+	ParabolaCalculator::ParabolaInfo GetDesign(const std::size_t& index) const;
+};
+
+#endif// DESIGN_SWEEP_H_
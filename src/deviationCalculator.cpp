@@ -0,0 +1,130 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  deviationCalculator.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Deviation of the faceted surface from the ideal paraboloid over the whole dish.
+
+// Local headers
+#include "deviationCalculator.h"
+
+// Eigen headers
+#include <Eigen/Eigen>
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+DeviationCalculator::Field DeviationCalculator::ComputeField(const unsigned int& radiusCount, const unsigned int& azimuthCount, const double& threshold) const
+{
+	const auto separable(BuildSeparableField(radiusCount, azimuthCount));
+
+	Field field;
+	field.radius = separable.radius;
+	field.azimuth = separable.azimuth;
+	field.axial.resize(static_cast<std::size_t>(radiusCount) * azimuthCount);
+	field.normal.resize(field.axial.size());
+
+	// Each field is an outer product, which Eigen evaluates with packet (SIMD) operations
+	typedef Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMajorArray;
+	const Eigen::Map<const Eigen::VectorXd> angularFactor(separable.angularFactor.data(), azimuthCount);
+	Eigen::Map<RowMajorArray>(field.axial.data(), radiusCount, azimuthCount) =
+		-(Eigen::Map<const Eigen::VectorXd>(separable.axialScale.data(), radiusCount) * angularFactor.transpose()).array();
+	Eigen::Map<RowMajorArray>(field.normal.data(), radiusCount, azimuthCount) =
+		-(Eigen::Map<const Eigen::VectorXd>(separable.normalScale.data(), radiusCount) * angularFactor.transpose()).array();
+
+	std::vector<double> sortedAngularFactor(separable.angularFactor);
+	std::sort(sortedAngularFactor.begin(), sortedAngularFactor.end());
+	ComputeStatistics(separable, separable.axialScale, sortedAngularFactor, threshold, field.axialStatistics);
+	ComputeStatistics(separable, separable.normalScale, sortedAngularFactor, threshold, field.normalStatistics);
+	field.totalArea = M_PI * 0.25 * calculator.GetParabolaInfo().diameter * calculator.GetParabolaInfo().diameter;
+
+	return field;
+}
+
+bool DeviationCalculator::ComputeStatistics(const unsigned int& radiusCount, const unsigned int& azimuthCount, const double& threshold,
+	Statistics& axialStatistics, Statistics& normalStatistics, const std::function<bool()>& isCancelled) const
+{
+	const auto separable(BuildSeparableField(radiusCount, azimuthCount));
+	std::vector<double> sortedAngularFactor(separable.angularFactor);
+	std::sort(sortedAngularFactor.begin(), sortedAngularFactor.end());
+	return ComputeStatistics(separable, separable.axialScale, sortedAngularFactor, threshold, axialStatistics, isCancelled) &&
+		ComputeStatistics(separable, separable.normalScale, sortedAngularFactor, threshold, normalStatistics, isCancelled);
+}
+
+DeviationCalculator::SeparableField DeviationCalculator::BuildSeparableField(const unsigned int& radiusCount, const unsigned int& azimuthCount) const
+{
+	const auto& info(calculator.GetParabolaInfo());
+	const double radiusStep(0.5 * info.diameter / radiusCount);
+	const double azimuthStep(2.0 * M_PI / azimuthCount);
+	const double goreAngle(2.0 * M_PI / info.facetCount);
+
+	SeparableField field;
+	field.cellArea = radiusStep * azimuthStep;
+
+	field.radius.resize(radiusCount);
+	field.axialScale.resize(radiusCount);
+	field.normalScale.resize(radiusCount);
+	for (unsigned int i = 0; i < radiusCount; ++i)
+	{
+		const double rho((i + 0.5) * radiusStep);
+		const double slope(0.5 * rho / info.focusPosition);
+		field.radius[i] = rho;
+		field.axialScale[i] = 0.25 * rho * rho / info.focusPosition;
+		field.normalScale[i] = field.axialScale[i] / sqrt(1.0 + slope * slope);
+	}
+
+	field.azimuth.resize(azimuthCount);
+	field.angularFactor.resize(azimuthCount);
+	for (unsigned int j = 0; j < azimuthCount; ++j)
+	{
+		const double phi((j + 0.5) * azimuthStep);
+		const double delta(phi - goreAngle * std::round(phi / goreAngle));
+		const double sinDelta(sin(delta));
+		field.azimuth[j] = phi;
+		field.angularFactor[j] = sinDelta * sinDelta;
+	}
+
+	return field;
+}
+
+// With deviation magnitude scale[i] * angularFactor[j], the statistics reduce to sums over each direction separately
+// (cells are weighted by their area, rho * dRho * dPhi)
+bool DeviationCalculator::ComputeStatistics(const SeparableField& field, const std::vector<double>& scale,
+	const std::vector<double>& sortedAngularFactor, const double& threshold, Statistics& statistics,
+	const std::function<bool()>& isCancelled)
+{
+	statistics = Statistics();
+	statistics.maximum = *std::max_element(scale.begin(), scale.end()) * sortedAngularFactor.back();
+
+	double angularSumOfSquares(0.0);
+	for (const auto& factor : sortedAngularFactor)
+		angularSumOfSquares += factor * factor;
+
+	double radialSumOfSquares(0.0), radialSum(0.0);
+	for (unsigned int i = 0; i < scale.size(); ++i)
+	{
+		if (isCancelled && isCancelled())
+			return false;
+
+		radialSumOfSquares += field.radius[i] * scale[i] * scale[i];
+		radialSum += field.radius[i];
+
+		if (scale[i] > 0.0)
+		{
+			const auto cellsAbove(sortedAngularFactor.end() - std::upper_bound(sortedAngularFactor.begin(), sortedAngularFactor.end(), threshold / scale[i]));
+			statistics.areaAboveThreshold += field.radius[i] * cellsAbove;
+		}
+	}
+
+	statistics.rms = sqrt(radialSumOfSquares * angularSumOfSquares / (radialSum * sortedAngularFactor.size()));
+	statistics.areaAboveThreshold *= field.cellArea;
+	return true;
+}
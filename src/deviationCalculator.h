@@ -0,0 +1,86 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  deviationCalculator.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Deviation of the faceted surface from the ideal paraboloid over the whole dish.
+
+#ifndef DEVIATION_CALCULATOR_H_
+#define DEVIATION_CALCULATOR_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+
+// Standard C++ headers
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+class DeviationCalculator
+{
+public:
+	explicit DeviationCalculator(const ParabolaCalculator::ParabolaInfo& info) : calculator(info) {}
+
+	struct Statistics
+	{
+		double maximum = 0.0;// [in] largest magnitude
+		double rms = 0.0;// [in] area-weighted
+		double areaAboveThreshold = 0.0;// [in^2] projected area where the magnitude exceeds the threshold
+	};
+
+	// Deviations on a grid of cell centers in radius and azimuth (measured from the center line of the first gore),
+	// stored row-major with one row of azimuth.size() values per radius.  Positive deviations are toward the focus
+	// side of the ideal surface (faceted dishes are never on that side).  Axial deviation is measured parallel to the
+	// dish axis and normal deviation perpendicular to the ideal surface (to first order in the deviation).  Gaps
+	// between gores are ignored; each gore surface is taken to extend to the seam.
+	struct Field
+	{
+		std::vector<double> radius;// [in]
+		std::vector<double> azimuth;// [rad]
+		std::vector<double> axial;// [in]
+		std::vector<double> normal;// [in]
+
+		Statistics axialStatistics;
+		Statistics normalStatistics;
+		double totalArea;// [in^2] projected area of the aperture
+
+		double GetAxial(const std::size_t& radiusIndex, const std::size_t& azimuthIndex) const { return axial[radiusIndex * azimuth.size() + azimuthIndex]; }
+		double GetNormal(const std::size_t& radiusIndex, const std::size_t& azimuthIndex) const { return normal[radiusIndex * azimuth.size() + azimuthIndex]; }
+	};
+
+	Field ComputeField(const unsigned int& radiusCount, const unsigned int& azimuthCount, const double& threshold) const;
+
+	// Statistics only (same values as ComputeField), without storing the field.  isCancelled (if set) is polled once
+	// per radius row; returns false if it asked to stop, leaving the statistics incomplete.
+	bool ComputeStatistics(const unsigned int& radiusCount, const unsigned int& azimuthCount, const double& threshold,
+		Statistics& axialStatistics, Statistics& normalStatistics, const std::function<bool()>& isCancelled = std::function<bool()>()) const;
+
+private:
+	const ParabolaCalculator calculator;
+
+	// The faceted surface above (rho, phi) is at z = (rho * cos(delta))^2 / (4 * a), where delta is the azimuth relative
+	// to the nearest gore center line, so the axial deviation separates into -(rho^2 / (4 * a)) * sin^2(delta).
+	struct SeparableField
+	{
+		std::vector<double> radius;// [in]
+		std::vector<double> azimuth;// [rad]
+		std::vector<double> axialScale;// [in] rho^2 / (4 * a)
+		std::vector<double> normalScale;// [in] axialScale projected onto the surface normal
+		std::vector<double> angularFactor;// [-] sin^2(delta)
+		double cellArea;// [in^2] per unit radius
+	};
+
+	SeparableField BuildSeparableField(const unsigned int& radiusCount, const unsigned int& azimuthCount) const;
+	static bool ComputeStatistics(const SeparableField& field, const std::vector<double>& scale,
+		const std::vector<double>& sortedAngularFactor, const double& threshold, Statistics& statistics,
+		const std::function<bool()>& isCancelled = std::function<bool()>());
+};
+
+#endif// DEVIATION_CALCULATOR_H_
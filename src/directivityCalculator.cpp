@@ -0,0 +1,155 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  directivityCalculator.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Off-axis gain calculations for parabolic reflectors.
+
+// Local headers
+#include "directivityCalculator.h"
+#include "gaussLegendre.h"
+#include "threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+// The model:  a plane wave arrives at angle theta from the axis and each surface element reflects it to the focus.
+// For a surface point at radius rho, azimuth phi and height z = rho^2 / (4 * a), the path from the incoming wavefront
+// to the focus (relative to the on-axis path, which is the same for every point on a paraboloid) is
+//     delta = z * (1 - cos(theta)) - rho * cos(phi) * sin(theta)
+// so the pressure at the focus relative to on-axis is the weighted surface average of exp(i * k * delta).
+// The azimuthal integral has the closed form 2 * pi * J0(k * rho * sin(theta)), leaving a single radial
+// Gauss-Legendre sum.  Elements are weighted by projected area and 1 / distance to focus.  The resulting
+// off-axis loss is added to the on-axis gain from ParabolaCalculator.
+DirectivityCalculator::GainMap DirectivityCalculator::ComputeGainMap(const std::vector<double>& angles, const std::vector<double>& frequencies) const
+{
+	GainMap map;
+	map.angle = angles;
+	map.frequency = frequencies;
+	map.gain.resize(angles.size() * frequencies.size());
+	if (map.gain.empty())
+		return map;
+
+	std::vector<double> onAxisGain(frequencies.size());
+	calculator.ComputeResponse(frequencies.data(), onAxisGain.data(), static_cast<unsigned int>(frequencies.size()));
+
+	std::vector<double> wavenumber(frequencies.size());
+	for (unsigned int i = 0; i < frequencies.size(); ++i)
+		wavenumber[i] = 2.0 * M_PI * frequencies[i] / ParabolaCalculator::speedOfSound;// [rad/in]
+
+	const auto quadrature(BuildQuadrature(*std::max_element(wavenumber.begin(), wavenumber.end())));
+	const std::size_t nodeCount(quadrature.weight.size());
+
+	ThreadPool pool(threadCount);
+	pool.ParallelFor(angles.size(), [&](const std::size_t& i)
+	{
+		const double theta(angles[i] * M_PI / 180.0);
+		const double sinTheta(sin(theta));
+		const double oneMinusCosTheta(1.0 - cos(theta));
+
+		std::vector<double> lateral(nodeCount), axial(nodeCount);
+		for (std::size_t n = 0; n < nodeCount; ++n)
+		{
+			lateral[n] = quadrature.radius[n] * sinTheta;
+			axial[n] = quadrature.height[n] * oneMinusCosTheta;
+		}
+
+		double* row(map.gain.data() + i * frequencies.size());
+		for (std::size_t j = 0; j < frequencies.size(); ++j)
+		{
+			const double k(wavenumber[j]);
+			double real(0.0), imaginary(0.0);
+			for (std::size_t n = 0; n < nodeCount; ++n)
+			{
+				const double amplitude(quadrature.weight[n] * BesselJ0(k * lateral[n]));
+				real += amplitude * cos(k * axial[n]);
+				imaginary += amplitude * sin(k * axial[n]);
+			}
+
+			row[j] = onAxisGain[j] + 10.0 * log10(real * real + imaginary * imaginary);
+		}
+	});
+
+	return map;
+}
+
+DirectivityCalculator::SurfaceQuadrature DirectivityCalculator::BuildQuadrature(const double& maxWavenumber) const
+{
+	const auto& info(calculator.GetParabolaInfo());
+	const double rimRadius(0.5 * info.diameter);
+	const double depth(calculator.GetParabolaDepth());
+
+	// Total phase variation across the radius is at most k * (R + l) for angles up to 90 deg.
+	// Gauss-Legendre needs a little more than one point per radian of phase for this integrand.
+	const double phaseRange(maxWavenumber * (rimRadius + depth));// [rad]
+	const auto order(static_cast<unsigned int>(ceil(quadratureScale * (0.6 * phaseRange + 16.0))));
+	const auto rule(GaussLegendre::GetRule(order, 0.0, rimRadius));
+
+	SurfaceQuadrature quadrature;
+	quadrature.radius = rule.node;
+	quadrature.height.resize(order);
+	quadrature.weight.resize(order);
+
+	double weightSum(0.0);
+	for (unsigned int i = 0; i < order; ++i)
+	{
+		const double r(rule.node[i]);
+		quadrature.height[i] = r * r * 0.25 / info.focusPosition;
+		quadrature.weight[i] = rule.weight[i] * r / (quadrature.height[i] + info.focusPosition);
+		weightSum += quadrature.weight[i];
+	}
+
+	for (auto& w : quadrature.weight)
+		w /= weightSum;
+
+	return quadrature;
+}
+
+// Power series for small arguments (cancellation costs at most ~4 digits below x = 12),
+// Hankel asymptotic expansion above that.
+double DirectivityCalculator::BesselJ0(const double& x)
+{
+	const double ax(fabs(x));
+	if (ax < 12.0)
+	{
+		const double y(-0.25 * ax * ax);
+		double term(1.0);
+		double sum(1.0);
+		for (unsigned int m = 1; m < 60; ++m)
+		{
+			term *= y / (static_cast<double>(m) * m);
+			sum += term;
+			if (fabs(term) < 1.0e-17 * fabs(sum))
+				break;
+		}
+		return sum;
+	}
+
+	// J0(x) ~ sqrt(2 / (pi * x)) * (P * cos(x - pi / 4) - Q * sin(x - pi / 4)),
+	// with coefficients a_k = a_(k-1) * (2k - 1)^2 / (8k)
+	const double inverseX(1.0 / ax);
+	double coefficient(1.0);
+	double power(1.0);
+	double p(1.0), q(0.0);
+	for (unsigned int k = 1; k <= 12; ++k)
+	{
+		coefficient *= (2.0 * k - 1.0) * (2.0 * k - 1.0) / (8.0 * k);
+		power *= inverseX;
+		const double term(coefficient * power);
+		if (k % 2 == 1)
+			q += ((k + 1) / 2) % 2 == 1 ? -term : term;
+		else
+			p += (k / 2) % 2 == 1 ? -term : term;
+	}
+
+	const double chi(ax - 0.25 * M_PI);
+	return sqrt(2.0 / (M_PI * ax)) * (p * cos(chi) - q * sin(chi));
+}
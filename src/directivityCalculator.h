@@ -0,0 +1,68 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  directivityCalculator.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Off-axis gain calculations for parabolic reflectors.
+
+#ifndef DIRECTIVITY_CALCULATOR_H_
+#define DIRECTIVITY_CALCULATOR_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+
+// Standard C++ headers
+#include <vector>
+#include <cstddef>
+
+class DirectivityCalculator
+{
+public:
+	explicit DirectivityCalculator(const ParabolaCalculator::ParabolaInfo& info) : calculator(info) {}
+
+	// Gain for each (angle, frequency) pair, stored row-major with one row of frequency.size() values per angle
+	struct GainMap
+	{
+		std::vector<double> angle;// [deg]
+		std::vector<double> frequency;// [Hz]
+		std::vector<double> gain;// [dB]
+
+		double GetGain(const std::size_t& angleIndex, const std::size_t& frequencyIndex) const { return gain[angleIndex * frequency.size() + frequencyIndex]; }
+	};
+
+	// Angles are measured from the reflector axis and should be less than 90 deg (no shadowing is modeled)
+	GainMap ComputeGainMap(const std::vector<double>& angles, const std::vector<double>& frequencies) const;
+
+	// Scales the number of radial quadrature points above the minimum required to resolve the highest frequency
+	void SetQuadratureScale(const double& scale) { quadratureScale = scale; }
+
+	// Zero threads means "use one thread per core"
+	void SetThreadCount(const unsigned int& count) { threadCount = count; }
+
+private:
+	const ParabolaCalculator calculator;
+
+	double quadratureScale = 1.0;
+	unsigned int threadCount = 0;
+
+	// Surface quadrature, built once for the highest requested frequency and reused for every cell
+	struct SurfaceQuadrature
+	{
+		std::vector<double> radius;// [in]
+		std::vector<double> height;// [in]
+		std::vector<double> weight;// [in] normalized so on-axis response sums to one
+	};
+
+	SurfaceQuadrature BuildQuadrature(const double& maxWavenumber) const;
+
+	static double BesselJ0(const double& x);
+};
+
+#endif// DIRECTIVITY_CALCULATOR_H_
@@ -0,0 +1,40 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  dishCatalog.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Standard dish sizes, with derived quantities computed at compile time.
+
+// Local headers
+#include "dishCatalog.h"
+
+// Standard C++ headers
+#include <cassert>
+
+namespace DishCatalog
+{
+
+ParabolaCalculator::Vector2DVectors GetFacetShape(const unsigned int& entryIndex)
+{
+	assert(entryIndex < entryCount);
+	const auto& outline(outlines[entryIndex]);
+
+	const unsigned int pointCount(2 * outlinePointCount);
+	ParabolaCalculator::Vector2DVectors shape(pointCount);
+	for (unsigned int i = 0; i < outlinePointCount; ++i)
+	{
+		shape[i] = Eigen::Vector2d(outline.arcLength[i], outline.halfWidth[i]);
+		shape[pointCount - 1 - i] = Eigen::Vector2d(outline.arcLength[i], -outline.halfWidth[i]);
+	}
+
+	return shape;
+}
+
+}// namespace DishCatalog
@@ -0,0 +1,106 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  dishCatalog.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Standard dish sizes, with derived quantities computed at compile time.
+
+#ifndef DISH_CATALOG_H_
+#define DISH_CATALOG_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+
+// Standard C++ headers
+#include <array>
+#include <utility>
+
+namespace DishCatalog
+{
+
+struct Entry
+{
+	const char* name;
+	ParabolaCalculator::ParabolaInfo info;
+	double depth;// [in]
+	double maxDesignError;// [in]
+};
+
+// Half of the facet outline (the other half is the mirror image about the x-axis), sampled at
+// evenly spaced radii from the apex to the rim, exactly as ParabolaCalculator::GetFacetShape does
+constexpr unsigned int outlinePointCount(100);
+struct FacetOutline
+{
+	double arcLength[outlinePointCount];// [in]
+	double halfWidth[outlinePointCount];// [in]
+};
+
+constexpr Entry MakeEntry(const char* name, const double& diameter, const double& focusPosition, const unsigned int& facetCount)
+{
+	ParabolaCalculator::ParabolaInfo info;
+	info.diameter = diameter;
+	info.focusPosition = focusPosition;
+	info.facetCount = facetCount;
+
+	const ParabolaCalculator calculator(info);
+	return Entry{ name, info, calculator.GetParabolaDepth(), calculator.GetMaxDesignError() };
+}
+
+constexpr FacetOutline MakeFacetOutline(const ParabolaCalculator::ParabolaInfo& info)
+{
+	const ParabolaCalculator calculator(info);
+	const double radiusStep(0.5 * info.diameter / (outlinePointCount - 1));
+
+	FacetOutline outline{};
+	for (unsigned int i = 0; i < outlinePointCount; ++i)
+	{
+		outline.arcLength[i] = calculator.ComputeParabolaArcLength(i * radiusStep);
+		outline.halfWidth[i] = calculator.ComputeFacetHalfWidth(i * radiusStep);
+	}
+
+	return outline;
+}
+
+constexpr Entry entries[] = {
+	MakeEntry("18 in", 18.0, 4.5, 8),
+	MakeEntry("22 in", 22.0, 5.5, 10),
+	MakeEntry("24 in", 24.0, 6.0, 10),
+	MakeEntry("30 in", 30.0, 7.5, 12),
+	MakeEntry("36 in", 36.0, 9.0, 16)
+};
+
+constexpr unsigned int entryCount(sizeof(entries) / sizeof(entries[0]));
+
+// One outline per entry, generated from the list so the two can't get out of step
+template<std::size_t... i>
+constexpr std::array<FacetOutline, entryCount> MakeFacetOutlines(std::index_sequence<i...>)
+{
+	return {{ MakeFacetOutline(entries[i].info)... }};
+}
+
+constexpr auto outlines(MakeFacetOutlines(std::make_index_sequence<entryCount>()));
+
+// Builds the full closed outline in the same form as ParabolaCalculator::GetFacetShape(2 * outlinePointCount)
+ParabolaCalculator::Vector2DVectors GetFacetShape(const unsigned int& entryIndex);
+
+// Compile-time checks on the constexpr math and the baked tables
+static_assert(ConstexprMath::Abs(ConstexprMath::Sqrt(2.0) - M_SQRT2) < 1.0e-15, "Sqrt accuracy");
+static_assert(ConstexprMath::Abs(ConstexprMath::Log(10.0) - M_LN10) < 1.0e-15, "Log accuracy");
+static_assert(ConstexprMath::Abs(ConstexprMath::Log(0.001) + 3.0 * M_LN10) < 1.0e-14, "Log accuracy");
+static_assert(ConstexprMath::Abs(entries[2].depth - 6.0) < 1.0e-12, "24 in dish with 6 in focus should be 6 in deep");
+// Seam distance for the 24 in, 10 facet dish satisfies (12 + e)^2 = 12^2 + (1.2 * pi)^2
+static_assert(ConstexprMath::Abs((12.0 + entries[2].maxDesignError) * (12.0 + entries[2].maxDesignError) - 144.0 - 1.44 * M_PI * M_PI) < 1.0e-12, "Design error accuracy");
+static_assert(outlines[0].arcLength[0] == 0.0 && outlines[0].halfWidth[0] == 0.0, "Outline must start at the apex");
+// Arc length of y = x^2 / (4 * a) from 0 to 2a is a * (sqrt(2) + ln(1 + sqrt(2)))
+static_assert(ConstexprMath::Abs(outlines[0].arcLength[outlinePointCount - 1] - 4.5 * (M_SQRT2 + ConstexprMath::Log(1.0 + M_SQRT2))) < 1.0e-12, "Arc length accuracy");
+
+}// namespace DishCatalog
+
+#endif// DISH_CATALOG_H_
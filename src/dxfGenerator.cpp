@@ -0,0 +1,165 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  dxfGenerator.cpp
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Writes outlines to a DXF file as closed LWPOLYLINE entities, one layer per sheet.
+
+// Local headers
+#include "dxfGenerator.h"
+
+// Standard C++ headers
+#include <cstdio>
+
+// Writes the minimal structure R2000 readers require:  handles and subclass markers on everything, the nine symbol
+// tables with their standard entries, the model and paper space blocks, and the root and group dictionaries.  Every
+// value is preceded by its group code on a line of its own.
+void DXFGenerator::WriteHeader(const unsigned int& sheetCount, const unsigned int& pathCount, OutputBuffer& out)
+{
+	nextHandle = 1;
+	rootDictionaryHandle = nextHandle++;
+	groupDictionaryHandle = nextHandle++;
+
+	// Tables and blocks are formatted first, so the handle seed (which comes before them) accounts for their handles
+	OutputBuffer tables(out.GetPrecision());
+	WriteTables(sheetCount, tables);
+	const unsigned int handleSeed(nextHandle + pathCount);
+
+	out << "0\nSECTION\n2\nHEADER\n"
+		<< "9\n$ACADVER\n1\nAC1015\n"// LWPOLYLINE needs R2000 or later
+		<< "9\n$HANDSEED\n5\n" << ToHex(handleSeed) << '\n'
+		<< "9\n$INSUNITS\n70\n4\n"// [mm]
+		<< "0\nENDSEC\n"
+		<< "0\nSECTION\n2\nCLASSES\n0\nENDSEC\n"
+		<< tables.GetString()
+		<< "0\nSECTION\n2\nENTITIES\n";
+}
+
+void DXFGenerator::WriteTables(const unsigned int& sheetCount, OutputBuffer& out)
+{
+	auto beginTable([this, &out](const char* name, const unsigned int& entryCount)
+	{
+		const unsigned int handle(nextHandle++);
+		out << "0\nTABLE\n2\n" << name << "\n5\n" << ToHex(handle) << "\n330\n0\n100\nAcDbSymbolTable\n70\n" << entryCount << '\n';
+		return handle;
+	});
+
+	auto beginEntry([this, &out](const char* type, const unsigned int& table, const char* subclass, const std::string& name)
+	{
+		const unsigned int handle(nextHandle++);
+		out << "0\n" << type << '\n' << (std::string(type) == "DIMSTYLE" ? "105" : "5") << '\n' << ToHex(handle)
+			<< "\n330\n" << ToHex(table) << "\n100\nAcDbSymbolTableRecord\n100\n" << subclass << "\n2\n" << name << '\n';
+		return handle;
+	});
+
+	const char* endTable("0\nENDTAB\n");
+
+	out << "0\nSECTION\n2\nTABLES\n";
+
+	// Readers supply the viewport, view and UCS defaults themselves
+	beginTable("VPORT", 0);
+	out << endTable;
+
+	const unsigned int lineTypeTable(beginTable("LTYPE", 3));
+	for (const char* lineType : { "ByBlock", "ByLayer", "Continuous" })
+	{
+		beginEntry("LTYPE", lineTypeTable, "AcDbLinetypeTableRecord", lineType);
+		out << "70\n0\n3\n" << (std::string(lineType) == "Continuous" ? "Solid line" : "") << "\n72\n65\n73\n0\n40\n0\n";
+	}
+	out << endTable;
+
+	const unsigned int layerTable(beginTable("LAYER", sheetCount + 1));
+	for (unsigned int i = 0; i <= sheetCount; ++i)
+	{
+		beginEntry("LAYER", layerTable, "AcDbLayerTableRecord", i == 0 ? std::string("0") : "SHEET" + std::to_string(i));
+		out << "70\n0\n62\n7\n6\nContinuous\n";
+	}
+	out << endTable;
+
+	const unsigned int styleTable(beginTable("STYLE", 1));
+	beginEntry("STYLE", styleTable, "AcDbTextStyleTableRecord", "Standard");
+	out << "70\n0\n40\n0\n41\n1\n50\n0\n71\n0\n42\n2.5\n3\ntxt\n4\n\n" << endTable;
+
+	beginTable("VIEW", 0);
+	out << endTable;
+	beginTable("UCS", 0);
+	out << endTable;
+
+	const unsigned int appTable(beginTable("APPID", 1));
+	beginEntry("APPID", appTable, "AcDbRegAppTableRecord", "ACAD");
+	out << "70\n0\n" << endTable;
+
+	const unsigned int dimensionStyleTable(beginTable("DIMSTYLE", 1));
+	out << "100\nAcDbDimStyleTable\n";
+	beginEntry("DIMSTYLE", dimensionStyleTable, "AcDbDimStyleTableRecord", "Standard");
+	out << "70\n0\n" << endTable;
+
+	const unsigned int blockRecordTable(beginTable("BLOCK_RECORD", 2));
+	modelSpaceHandle = beginEntry("BLOCK_RECORD", blockRecordTable, "AcDbBlockTableRecord", "*Model_Space");
+	const unsigned int paperSpaceHandle(beginEntry("BLOCK_RECORD", blockRecordTable, "AcDbBlockTableRecord", "*Paper_Space"));
+	out << endTable;
+
+	out << "0\nENDSEC\n";
+
+	WriteBlocks(paperSpaceHandle, out);
+}
+
+// Both layout blocks are required, even though they're empty (entities go in the ENTITIES section)
+void DXFGenerator::WriteBlocks(const unsigned int& paperSpaceHandle, OutputBuffer& out)
+{
+	out << "0\nSECTION\n2\nBLOCKS\n";
+	for (const auto& block : { std::make_pair(modelSpaceHandle, "*Model_Space"), std::make_pair(paperSpaceHandle, "*Paper_Space") })
+	{
+		const std::string owner(ToHex(block.first));
+		const char* paperSpaceFlag(block.first == paperSpaceHandle ? "67\n1\n" : "");
+		out << "0\nBLOCK\n5\n" << ToHex(nextHandle++) << "\n330\n" << owner << "\n100\nAcDbEntity\n" << paperSpaceFlag
+			<< "8\n0\n100\nAcDbBlockBegin\n2\n" << block.second << "\n70\n0\n10\n0\n20\n0\n30\n0\n3\n" << block.second << "\n1\n\n";
+		out << "0\nENDBLK\n5\n" << ToHex(nextHandle++) << "\n330\n" << owner << "\n100\nAcDbEntity\n" << paperSpaceFlag
+			<< "8\n0\n100\nAcDbBlockEnd\n";
+	}
+	out << "0\nENDSEC\n";
+}
+
+void DXFGenerator::BeginSheet(const unsigned int& /*sheet*/, OutputBuffer& /*out*/)
+{
+	// Sheets are distinguished by layer
+}
+
+void DXFGenerator::WritePath(const Vector2DVectors& path, const unsigned int& sheet, OutputBuffer& out)
+{
+	out << "0\nLWPOLYLINE\n"
+		<< "5\n" << ToHex(nextHandle++) << '\n'
+		<< "330\n" << ToHex(modelSpaceHandle) << '\n'
+		<< "100\nAcDbEntity\n"
+		<< "8\nSHEET" << sheet + 1 << '\n'
+		<< "100\nAcDbPolyline\n"
+		<< "90\n" << path.size() << '\n'
+		<< "70\n1\n";// Closed
+	for (const auto& p : path)
+		out << "10\n" << p(0) << "\n20\n" << p(1) << '\n';
+}
+
+void DXFGenerator::WriteFooter(OutputBuffer& out)
+{
+	out << "0\nENDSEC\n"
+		<< "0\nSECTION\n2\nOBJECTS\n"
+		<< "0\nDICTIONARY\n5\n" << ToHex(rootDictionaryHandle) << "\n330\n0\n100\nAcDbDictionary\n281\n1\n"
+		<< "3\nACAD_GROUP\n350\n" << ToHex(groupDictionaryHandle) << '\n'
+		<< "0\nDICTIONARY\n5\n" << ToHex(groupDictionaryHandle) << "\n330\n" << ToHex(rootDictionaryHandle) << "\n100\nAcDbDictionary\n281\n1\n"
+		<< "0\nENDSEC\n"
+		<< "0\nEOF\n";
+}
+
+std::string DXFGenerator::ToHex(const unsigned int& handle)
+{
+	char text[9];
+	std::snprintf(text, sizeof(text), "%X", handle);
+	return text;
+}
@@ -0,0 +1,45 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  dxfGenerator.h
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Writes outlines to a DXF file as closed LWPOLYLINE entities, one layer per sheet.
+
+#ifndef DXF_GENERATOR_H_
+#define DXF_GENERATOR_H_
+
+// Local headers
+#include "cutPathGenerator.h"
+
+// Standard C++ headers
+#include <string>
+
+class DXFGenerator : public CutPathGenerator
+{
+protected:
+	void WriteHeader(const unsigned int& sheetCount, const unsigned int& pathCount, OutputBuffer& out) override;
+	void BeginSheet(const unsigned int& sheet, OutputBuffer& out) override;
+	void WritePath(const Vector2DVectors& path, const unsigned int& sheet, OutputBuffer& out) override;
+	void WriteFooter(OutputBuffer& out) override;
+
+private:
+	// Every object in an R2000 file has a unique handle (written in hex); the header records the next unused one
+	unsigned int nextHandle;
+	unsigned int modelSpaceHandle;// Block record that owns the entities
+	unsigned int rootDictionaryHandle;
+	unsigned int groupDictionaryHandle;
+
+	static std::string ToHex(const unsigned int& handle);
+
+	void WriteTables(const unsigned int& sheetCount, OutputBuffer& out);
+	void WriteBlocks(const unsigned int& paperSpaceHandle, OutputBuffer& out);
+};
+
+#endif// DXF_GENERATOR_H_
@@ -0,0 +1,204 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  facetedResponseCalculator.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  On-axis gain of a dish built from flat gores, by integrating over the gore surfaces.
+
+// Local headers
+#include "facetedResponseCalculator.h"
+#include "gaussLegendre.h"
+#include "responseKernel.h"
+#include "threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+// The pressure at the focus is the direct wave plus the reflected wave, which (Kirchhoff approximation) is
+//     -i * kappa / (2 * pi) * integral of exp(i * kappa * path) / distance dA
+// over the projected aperture, with kappa = 2 * pi / lambda.  For a perfect paraboloid every path is the same and the
+// integral of dA / distance is 4 * pi * a * b, with b = log(1 + l / a), which gives the reflected term -i * x * exp(i * k)
+// with k = 4 * pi * a / lambda and x = k * b, exactly the model in ParabolaCalculator.  Each gore is the parabolic cylinder
+// z = x'^2 / (4 * a) in its own frame, so the distance to the focus is sqrt((z + a)^2 + y'^2) rather than z + a.
+// Writing C for the normalized integral of exp(i * kappa * delta) / distance (C = 1 for the perfect paraboloid), the
+// pressure is 1 - i * x * exp(i * k) * C.
+bool FacetedResponseCalculator::ComputeResponse(const double* frequency, double* gain, const unsigned int& count,
+	const std::function<bool()>& isCancelled) const
+{
+	if (count == 0)
+		return true;
+
+	const double maxFrequency(*std::max_element(frequency, frequency + count));
+	const auto quadrature(BuildQuadrature(2.0 * M_PI * maxFrequency / ParabolaCalculator::speedOfSound));
+
+	// Once any thread sees the request to stop, the rest skip their remaining frequencies without asking again
+	std::atomic<bool> cancelled(false);
+	ThreadPool pool(threadCount);
+	pool.ParallelFor(count, [this, &quadrature, frequency, gain, &isCancelled, &cancelled](const std::size_t& i)
+	{
+		if (cancelled || (isCancelled && isCancelled()))
+		{
+			cancelled = true;
+			return;
+		}
+
+		gain[i] = ComputeGain(quadrature, calculator, frequency[i]);
+	});
+
+	return !cancelled;
+}
+
+void FacetedResponseCalculator::ComputeResponse(const FacetedSurface& surface, const double* frequency, double* gain,
+	const unsigned int& count, const double& quadratureScale)
+{
+	if (count == 0)
+		return;
+
+	const double maxFrequency(*std::max_element(frequency, frequency + count));
+	const auto quadrature(BuildQuadrature(surface, 2.0 * M_PI * maxFrequency / ParabolaCalculator::speedOfSound, quadratureScale));
+
+	const ParabolaCalculator calculator(surface.GetParabolaInfo());
+	for (unsigned int i = 0; i < count; ++i)
+		gain[i] = ComputeGain(quadrature, calculator, frequency[i]);
+}
+
+double FacetedResponseCalculator::ComputeGain(const SurfaceQuadrature& quadrature, const ParabolaCalculator& calculator, const double& frequency)
+{
+	const auto& info(calculator.GetParabolaInfo());
+	const double kappa(2.0 * M_PI * frequency / ParabolaCalculator::speedOfSound);// [rad/in]
+	double real(0.0), imaginary(0.0);
+	ResponseKernel::SumPhasors(quadrature.pathDifference.data(), quadrature.weight.data(),
+		quadrature.weight.size(), kappa, real, imaginary);
+
+	const double b(log(1.0 + calculator.GetParabolaDepth() / info.focusPosition));// [-]
+	const double k(2.0 * kappa * info.focusPosition);
+	const double x(k * b);
+	const double sinK(sin(k));
+	const double cosK(cos(k));
+	const double pressureReal(1.0 + x * (sinK * real + cosK * imaginary));
+	const double pressureImaginary(x * (sinK * imaginary - cosK * real));
+	return 10.0 * log10(pressureReal * pressureReal + pressureImaginary * pressureImaginary);
+}
+
+ParabolaCalculator::Vector2DVectors FacetedResponseCalculator::GetResponse(const unsigned int& pointCount,
+	const double& maxFrequency, const ParabolaCalculator::FrequencySpacing& spacing) const
+{
+	std::vector<double> frequency(ParabolaCalculator::GetResponseFrequencies(pointCount, maxFrequency, spacing));
+	std::vector<double> gain(pointCount);
+	ComputeResponse(frequency.data(), gain.data(), pointCount);
+
+	ParabolaCalculator::Vector2DVectors response(pointCount);
+	for (unsigned int i = 0; i < pointCount; ++i)
+		response[i] = Eigen::Vector2d(frequency[i], gain[i]);
+	return response;
+}
+
+unsigned int FacetedResponseCalculator::GetQuadratureOrder(const double& maxWavenumber, const double& maxPathDifference, const double& quadratureScale)
+{
+	return static_cast<unsigned int>(ceil(quadratureScale * (0.5 * maxWavenumber * maxPathDifference + 12.0)));
+}
+
+// Gauss-Legendre in x' from the apex to the rim, and in y' from the center line to the gore edge at each x'.  The order
+// in each direction follows the largest phase difference across the gore (at the rim corner).
+FacetedResponseCalculator::SurfaceQuadrature FacetedResponseCalculator::BuildQuadrature(const double& maxWavenumber) const
+{
+	const auto& info(calculator.GetParabolaInfo());
+	const double a(info.focusPosition);
+	const double rimRadius(0.5 * info.diameter);
+	const double rimDistance(calculator.GetParabolaDepth() + a);
+	const double rimHalfWidth(calculator.ComputeFacetHalfWidth(rimRadius));
+	const double maxPathDifference(sqrt(rimDistance * rimDistance + rimHalfWidth * rimHalfWidth) - rimDistance);
+
+	const unsigned int order(GetQuadratureOrder(maxWavenumber, maxPathDifference, quadratureScale));
+	const auto radialRule(GaussLegendre::GetRule(order, 0.0, rimRadius));
+	const auto acrossRule(GaussLegendre::GetRule(order, 0.0, 1.0));
+
+	SurfaceQuadrature quadrature;
+	quadrature.pathDifference.reserve(order * order);
+	quadrature.weight.reserve(order * order);
+
+	// Perfect paraboloid's integral of dA / distance over one half-gore sector
+	const double idealWeight(4.0 * M_PI * a * log(1.0 + calculator.GetParabolaDepth() / a) / (2.0 * info.facetCount));
+	for (unsigned int i = 0; i < order; ++i)
+	{
+		const double xLocal(radialRule.node[i]);
+		const double axialDistance(0.25 * xLocal * xLocal / a + a);
+		const double halfWidth(calculator.ComputeFacetHalfWidth(xLocal));
+		for (unsigned int j = 0; j < order; ++j)
+		{
+			const double yLocal(acrossRule.node[j] * halfWidth);
+			const double distance(sqrt(axialDistance * axialDistance + yLocal * yLocal));
+			quadrature.pathDifference.push_back(distance - axialDistance);
+			quadrature.weight.push_back(radialRule.weight[i] * acrossRule.weight[j] * halfWidth / (distance * idealWeight));
+		}
+	}
+
+	return quadrature;
+}
+
+// Same scheme over the material coordinates of each gore, with the surface position (and so path difference and
+// projected area) from the possibly perturbed surface.  The order follows the largest path difference range on any gore.
+FacetedResponseCalculator::SurfaceQuadrature FacetedResponseCalculator::BuildQuadrature(const FacetedSurface& surface,
+	const double& maxWavenumber, const double& quadratureScale)
+{
+	const auto& info(surface.GetParabolaInfo());
+	const ParabolaCalculator calculator(info);
+	const double a(info.focusPosition);
+	const double rimRadius(0.5 * info.diameter);
+	const Eigen::Vector3d focus(0.0, 0.0, a);
+
+	auto pathDifference([&surface, &focus, &a](const unsigned int& gore, const double& u, const double& v)
+	{
+		const Eigen::Vector3d point(surface.GetMaterialPoint(gore, u, v));
+		return (point - focus).norm() - point.z() - a;
+	});
+
+	double maxPathDifferenceRange(0.0);
+	const double rimHalfWidth(calculator.ComputeFacetHalfWidth(rimRadius));
+	for (unsigned int gore = 0; gore < surface.GetGoreCount(); ++gore)
+	{
+		const double corners[] = { pathDifference(gore, 0.0, 0.0), pathDifference(gore, rimRadius, 0.0),
+			pathDifference(gore, rimRadius, rimHalfWidth), pathDifference(gore, rimRadius, -rimHalfWidth) };
+		const auto range(std::minmax_element(std::begin(corners), std::end(corners)));
+		maxPathDifferenceRange = std::max(maxPathDifferenceRange, *range.second - *range.first);
+	}
+
+	const unsigned int order(GetQuadratureOrder(maxWavenumber, maxPathDifferenceRange, quadratureScale));
+	const auto radialRule(GaussLegendre::GetRule(order, 0.0, rimRadius));
+	const auto acrossRule(GaussLegendre::GetRule(order, -1.0, 1.0));
+
+	SurfaceQuadrature quadrature;
+	const std::size_t pointCount(static_cast<std::size_t>(surface.GetGoreCount()) * order * order);
+	quadrature.pathDifference.reserve(pointCount);
+	quadrature.weight.reserve(pointCount);
+
+	const double idealWeight(4.0 * M_PI * a * log(1.0 + calculator.GetParabolaDepth() / a));
+	for (unsigned int gore = 0; gore < surface.GetGoreCount(); ++gore)
+	{
+		for (unsigned int i = 0; i < order; ++i)
+		{
+			const double u(radialRule.node[i]);
+			const double halfWidth(calculator.ComputeFacetHalfWidth(u));
+			const double areaRatio(surface.GetProjectedAreaRatio(gore, u));
+			for (unsigned int j = 0; j < order; ++j)
+			{
+				const double v(acrossRule.node[j] * halfWidth);
+				const Eigen::Vector3d point(surface.GetMaterialPoint(gore, u, v));
+				const double distance((point - focus).norm());
+				quadrature.pathDifference.push_back(distance - point.z() - a);
+				quadrature.weight.push_back(radialRule.weight[i] * acrossRule.weight[j] * halfWidth * areaRatio / (distance * idealWeight));
+			}
+		}
+	}
+
+	return quadrature;
+}
@@ -0,0 +1,74 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  facetedResponseCalculator.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  On-axis gain of a dish built from flat gores, by integrating over the gore surfaces.
+
+#ifndef FACETED_RESPONSE_CALCULATOR_H_
+#define FACETED_RESPONSE_CALCULATOR_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+#include "facetedSurface.h"
+
+// Standard C++ headers
+#include <vector>
+#include <functional>
+
+class FacetedResponseCalculator
+{
+public:
+	explicit FacetedResponseCalculator(const ParabolaCalculator::ParabolaInfo& info) : calculator(info) {}
+
+	// Evaluates the gain [dB] of the built (faceted) dish at each of the specified frequencies [Hz].  Directly
+	// comparable to ParabolaCalculator::ComputeResponse, which it matches exactly for a perfect paraboloid.
+	// isCancelled (if set) is polled before each frequency, possibly from several threads at once; returns false if it
+	// asked to stop, leaving the remaining gains unset.
+	bool ComputeResponse(const double* frequency, double* gain, const unsigned int& count,
+		const std::function<bool()>& isCancelled = std::function<bool()>()) const;
+
+	// Same calculation for any surface (including one with manufacturing errors), integrating over every gore
+	// individually.  Runs entirely on the calling thread, for callers that are already running in parallel.
+	static void ComputeResponse(const FacetedSurface& surface, const double* frequency, double* gain,
+		const unsigned int& count, const double& quadratureScale = 1.0);
+
+	ParabolaCalculator::Vector2DVectors GetResponse(const unsigned int& pointCount, const double& maxFrequency,
+		const ParabolaCalculator::FrequencySpacing& spacing = ParabolaCalculator::FrequencySpacing::Linear) const;
+
+	// Scales the number of quadrature points above the minimum required to resolve the highest frequency
+	void SetQuadratureScale(const double& scale) { quadratureScale = scale; }
+
+	// Zero threads means "use one thread per core"
+	void SetThreadCount(const unsigned int& count) { threadCount = count; }
+
+private:
+	const ParabolaCalculator calculator;
+
+	double quadratureScale = 1.0;
+	unsigned int threadCount = 0;
+
+	// Quadrature points on the reflecting surface, built once for the highest requested frequency
+	struct SurfaceQuadrature
+	{
+		std::vector<double> pathDifference;// [in] extra path length to the focus, relative to a perfect paraboloid
+		std::vector<double> weight;// [-] normalized by the perfect paraboloid's total for the same sector
+	};
+
+	// Half of one gore, when all half-gores are identical
+	SurfaceQuadrature BuildQuadrature(const double& maxWavenumber) const;
+	// Every gore of the specified surface
+	static SurfaceQuadrature BuildQuadrature(const FacetedSurface& surface, const double& maxWavenumber, const double& quadratureScale);
+
+	static unsigned int GetQuadratureOrder(const double& maxWavenumber, const double& maxPathDifference, const double& quadratureScale);
+	static double ComputeGain(const SurfaceQuadrature& quadrature, const ParabolaCalculator& calculator, const double& frequency);
+};
+
+#endif// FACETED_RESPONSE_CALCULATOR_H_
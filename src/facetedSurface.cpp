@@ -0,0 +1,142 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  facetedSurface.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Three-dimensional geometry of a dish assembled from flat gores.
+
+// Local headers
+#include "facetedSurface.h"
+
+// Standard C++ headers
+#include <cassert>
+#include <cmath>
+
+FacetedSurface::FacetedSurface(const ParabolaCalculator::ParabolaInfo& _info) : info(_info),
+	rimRadius(0.5 * info.diameter), halfWidthPerRadius(M_PI / info.facetCount), errors(info.facetCount), perturbed(false)
+{
+	Initialize();
+}
+
+FacetedSurface::FacetedSurface(const ParabolaCalculator::ParabolaInfo& _info, const std::vector<GoreError>& _errors) : info(_info),
+	rimRadius(0.5 * info.diameter), halfWidthPerRadius(M_PI / info.facetCount), errors(_errors), perturbed(true)
+{
+	assert(errors.size() == info.facetCount);
+	Initialize();
+}
+
+void FacetedSurface::Initialize()
+{
+	assert(info.facetCount > 2);
+
+	cosAzimuth.resize(info.facetCount);
+	sinAzimuth.resize(info.facetCount);
+	cosTilt.resize(info.facetCount);
+	sinTilt.resize(info.facetCount);
+	for (unsigned int i = 0; i < info.facetCount; ++i)
+	{
+		cosAzimuth[i] = cos(GetGoreAzimuth(i));
+		sinAzimuth[i] = sin(GetGoreAzimuth(i));
+		cosTilt[i] = cos(errors[i].tilt);
+		sinTilt[i] = sin(errors[i].tilt);
+	}
+}
+
+double FacetedSurface::GetGoreAzimuth(const unsigned int& gore) const
+{
+	return 2.0 * M_PI * gore / info.facetCount;
+}
+
+unsigned int FacetedSurface::GetGoreIndex(const double& x, const double& y) const
+{
+	double azimuth(atan2(y, x));
+	if (azimuth < 0.0)
+		azimuth += 2.0 * M_PI;
+	return static_cast<unsigned int>(std::lround(azimuth * info.facetCount / (2.0 * M_PI))) % info.facetCount;
+}
+
+Eigen::Vector2d FacetedSurface::ToGoreFrame(const unsigned int& gore, const double& x, const double& y) const
+{
+	return Eigen::Vector2d(x * cosAzimuth[gore] + y * sinAzimuth[gore], y * cosAzimuth[gore] - x * sinAzimuth[gore]);
+}
+
+Eigen::Vector2d FacetedSurface::FromGoreFrame(const unsigned int& gore, const double& xLocal, const double& yLocal) const
+{
+	return Eigen::Vector2d(xLocal * cosAzimuth[gore] - yLocal * sinAzimuth[gore], xLocal * sinAzimuth[gore] + yLocal * cosAzimuth[gore]);
+}
+
+bool FacetedSurface::GetSurfacePoint(const double& x, const double& y, Eigen::Vector3d& point, Eigen::Vector3d& normal) const
+{
+	const unsigned int gore(GetGoreIndex(x, y));
+	const bool hit(GetGorePoint(gore, x, y, point, normal));
+	if (!perturbed)
+		return hit;
+
+	// Perturbed gores can spill over the seam, so also check the neighbor on this side
+	const unsigned int neighbor(ToGoreFrame(gore, x, y).y() > 0.0 ? (gore + 1) % info.facetCount : (gore + info.facetCount - 1) % info.facetCount);
+	Eigen::Vector3d neighborPoint, neighborNormal;
+	if (!GetGorePoint(neighbor, x, y, neighborPoint, neighborNormal) || (hit && neighborPoint.z() <= point.z()))
+		return hit;
+
+	point = neighborPoint;
+	normal = neighborNormal;
+	return true;
+}
+
+// Solves x' = s * (u * cos(tilt) - u^2 / (4 * a) * sin(tilt)) + offset for u, choosing the root that reduces to
+// u = x' for a perfect gore
+bool FacetedSurface::SolveForMaterialRadius(const unsigned int& gore, const double& xLocal, double& u) const
+{
+	const double c((xLocal - errors[gore].radialOffset) / errors[gore].scale);
+	const double a(-0.25 * sinTilt[gore] / info.focusPosition);
+	const double discriminant(cosTilt[gore] * cosTilt[gore] + 4.0 * a * c);
+	if (discriminant < 0.0)
+		return false;
+
+	u = 2.0 * c / (cosTilt[gore] + sqrt(discriminant));
+	return true;
+}
+
+bool FacetedSurface::GetGorePoint(const unsigned int& gore, const double& x, const double& y, Eigen::Vector3d& point, Eigen::Vector3d& normal) const
+{
+	const Eigen::Vector2d local(ToGoreFrame(gore, x, y));
+	double u;
+	if (!SolveForMaterialRadius(gore, local.x(), u))
+		return false;
+
+	const double v(local.y() / errors[gore].scale);
+	if (u < 0.0 || u > rimRadius || std::abs(v) > halfWidthPerRadius * u)
+		return false;
+
+	const double height(0.25 * u * u / info.focusPosition);
+	point = Eigen::Vector3d(x, y, errors[gore].scale * (sinTilt[gore] * u + cosTilt[gore] * height));
+
+	// Normal is (-slope, 0, 1) in the gore frame before tilting (scaling doesn't change it)
+	const double slope(0.5 * u / info.focusPosition);
+	const double scale(1.0 / sqrt(1.0 + slope * slope));
+	const double normalX(-(cosTilt[gore] * slope + sinTilt[gore]) * scale);
+	const double normalZ((cosTilt[gore] - sinTilt[gore] * slope) * scale);
+	normal = Eigen::Vector3d(normalX * cosAzimuth[gore], normalX * sinAzimuth[gore], normalZ);
+	return true;
+}
+
+Eigen::Vector3d FacetedSurface::GetMaterialPoint(const unsigned int& gore, const double& u, const double& v) const
+{
+	const double height(0.25 * u * u / info.focusPosition);
+	const double xLocal(errors[gore].scale * (cosTilt[gore] * u - sinTilt[gore] * height) + errors[gore].radialOffset);
+	const double yLocal(errors[gore].scale * v);
+	const Eigen::Vector2d aperturePoint(FromGoreFrame(gore, xLocal, yLocal));
+	return Eigen::Vector3d(aperturePoint.x(), aperturePoint.y(), errors[gore].scale * (sinTilt[gore] * u + cosTilt[gore] * height));
+}
+
+double FacetedSurface::GetProjectedAreaRatio(const unsigned int& gore, const double& u) const
+{
+	return errors[gore].scale * errors[gore].scale * (cosTilt[gore] - sinTilt[gore] * 0.5 * u / info.focusPosition);
+}
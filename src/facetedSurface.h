@@ -0,0 +1,86 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  facetedSurface.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Three-dimensional geometry of a dish assembled from flat gores.
+
+#ifndef FACETED_SURFACE_H_
+#define FACETED_SURFACE_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+
+// Eigen headers
+#include <Eigen/Eigen>
+
+// Standard C++ headers
+#include <vector>
+
+// Each gore is the flat pattern from ParabolaCalculator::GetFacetShape, bent only along its center line.  In a frame
+// rotated to the gore's azimuth (x' outward along the center line, y' across the gore), the gore is the parabolic
+// cylinder z = u^2 / (4 * a) over material coordinates 0 <= u <= rim radius and |v| <= pi * u / N (x' = u, y' = v for
+// a perfectly made gore).  The dish axis is z, with the apex at the origin and the focus at z = a.
+class FacetedSurface
+{
+public:
+	// Manufacturing errors for one gore, applied in the gore frame in this order:  the whole gore is scaled about the
+	// apex, tilted about the y' axis through the apex and then moved outward along x'
+	struct GoreError
+	{
+		double radialOffset = 0.0;// [in]
+		double scale = 1.0;// [-]
+		double tilt = 0.0;// [rad] positive tips the rim toward the focus
+	};
+
+	explicit FacetedSurface(const ParabolaCalculator::ParabolaInfo& info);
+	FacetedSurface(const ParabolaCalculator::ParabolaInfo& info, const std::vector<GoreError>& errors);
+
+	const ParabolaCalculator::ParabolaInfo& GetParabolaInfo() const { return info; }
+	unsigned int GetGoreCount() const { return info.facetCount; }
+
+	double GetGoreAzimuth(const unsigned int& gore) const;// [rad]
+	unsigned int GetGoreIndex(const double& x, const double& y) const;// Gore with the nearest center line azimuth
+
+	// Local gore coordinates of the point (x, y) [in] in the aperture plane
+	Eigen::Vector2d ToGoreFrame(const unsigned int& gore, const double& x, const double& y) const;
+	Eigen::Vector2d FromGoreFrame(const unsigned int& gore, const double& xLocal, const double& yLocal) const;
+
+	// Surface point and unit normal (pointing toward the focus side) above the aperture point (x, y) [in].  Returns
+	// false if there's no material there (between gores or beyond the rim).  Where perturbed gores overlap, the
+	// uppermost one is used.
+	bool GetSurfacePoint(const double& x, const double& y, Eigen::Vector3d& point, Eigen::Vector3d& normal) const;
+
+	// Position [in] of the material point (u, v) of a gore, in global coordinates, and the ratio of projected
+	// (aperture plane) area to material area there
+	Eigen::Vector3d GetMaterialPoint(const unsigned int& gore, const double& u, const double& v) const;
+	double GetProjectedAreaRatio(const unsigned int& gore, const double& u) const;
+
+private:
+	const ParabolaCalculator::ParabolaInfo info;
+	const double rimRadius;// [in]
+	const double halfWidthPerRadius;// [-] gore half-width is this times u
+
+	std::vector<GoreError> errors;
+	bool perturbed;
+
+	std::vector<double> cosAzimuth;
+	std::vector<double> sinAzimuth;
+	std::vector<double> cosTilt;
+	std::vector<double> sinTilt;
+
+	void Initialize();
+
+	// Material coordinate u of the point on a gore that lies above local x' (false if there isn't one)
+	bool SolveForMaterialRadius(const unsigned int& gore, const double& xLocal, double& u) const;
+	bool GetGorePoint(const unsigned int& gore, const double& x, const double& y, Eigen::Vector3d& point, Eigen::Vector3d& normal) const;
+};
+
+#endif// FACETED_SURFACE_H_
@@ -0,0 +1,1012 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  flatPatternGenerator.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Base class for printable flat pattern writers.  Handles rotating the pattern, splitting it into pages and
+//        clipping it to each page, leaving only the file format to derived classes.
+
+// Local headers
+#include "flatPatternGenerator.h"
+#include "goreNester.h"
+#include "threadPool.h"
+
+// Standard C++ headers
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <cassert>
+#include <cmath>
+
+const FlatPatternGenerator::Vector2DVectors FlatPatternGenerator::scaleMark = {
+	Eigen::Vector2d(12.7, 0.0), Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(0.0, 12.7), Eigen::Vector2d(12.7, 12.7),
+	Eigen::Vector2d(12.7, 25.4), Eigen::Vector2d(0.0, 25.4), Eigen::Vector2d(0.0, 31.75), Eigen::Vector2d(6.35, 31.75),
+	Eigen::Vector2d(6.35, 38.1), Eigen::Vector2d(0.0, 38.1) };
+
+bool FlatPatternGenerator::WriteFlatPatterns(const Vector2DVectors& shape, const std::string& fileName)
+{
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	// The orientation with the fewest pages in its grid is tried first, so it's kept unless something else leaves
+	// fewer pages with anything on them
+	std::vector<double> angles(1, DetermineIdealRotationAngle(shape));// [deg]
+	const auto criticalAngles(GetCriticalRotationAngles(shape));
+	angles.insert(angles.end(), criticalAngles.begin(), criticalAngles.end());
+
+	ThreadPool pool(threadCount);
+	const auto layout(PlaceLayout(JoinOutlines(std::vector<Vector2DVectors>(1, shape)), angles, pool));
+
+	std::vector<PageOffset> offsets;
+	unsigned int yPages;
+	DeterminePageCount(layout.path, offsets, yPages);
+
+	WriteHeader(file);
+	bool scalePending(true);
+	WriteTiledPages(layout, offsets, yPages, scalePending, pool, file);
+	WriteFooter(file);
+	return file.good();
+}
+
+// The nester chooses its own orientation (only multiples of 90 deg, since the copies are fit around each other)
+bool FlatPatternGenerator::WriteNestedFlatPatterns(const Vector2DVectors& shape, const unsigned int& copies, const NestingTarget& target, const std::string& fileName)
+{
+	GoreNester nester(shape, nestingGap * 25.4);
+	nester.SetThreadCount(threadCount);
+	std::vector<std::vector<Vector2DVectors>> sheets;
+	if (target == NestingTarget::FewestPages)
+	{
+		sheets.push_back(nester.NestForFewestSheets(copies, [this](const double& width, const double& height)
+		{
+			return CountPages(pageWidth, width / 25.4) * CountPages(pageHeight, height / 25.4);
+		}));
+	}
+	else
+		sheets = nester.NestOnSheets(copies, (pageWidth - 2.0 * margin) * 25.4, (pageHeight - 2.0 * margin) * 25.4);
+
+	if (sheets.empty() || sheets.front().empty())
+		return false;
+
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	ThreadPool pool(threadCount);
+	WriteHeader(file);
+	bool scalePending(target == NestingTarget::FewestPages);
+	for (const auto& sheet : sheets)
+	{
+		std::vector<PageOffset> offsets;
+		unsigned int yPages;
+		if (target == NestingTarget::FewestPages)
+		{
+			const auto layout(PlaceLayout(JoinOutlines(sheet), std::vector<double>(1, 0.0), pool));
+			DeterminePageCount(layout.path, offsets, yPages);
+			WriteTiledPages(layout, offsets, yPages, scalePending, pool, file);
+		}
+		else
+		{
+			offsets.push_back(PageOffset(0.0, 0.0));// Start at the lower left corner, leaving the rest of the sheet in one piece
+			yPages = 1;
+			WriteTiledPages(JoinOutlines(sheet), offsets, yPages, scalePending, pool, file);
+		}
+	}
+
+	WriteFooter(file);
+	return file.good();
+}
+
+FlatPatternGenerator::Layout FlatPatternGenerator::JoinOutlines(const std::vector<Vector2DVectors>& outlines)
+{
+	Layout layout;
+	for (const auto& outline : outlines)
+	{
+		layout.outlineStart.push_back(layout.path.size());
+		layout.path.insert(layout.path.end(), outline.begin(), outline.end());
+		layout.path.push_back(outline.front());
+	}
+	layout.outlineStart.push_back(layout.path.size());
+
+	return layout;
+}
+
+// Rotates the layout by one of the angles [deg] and slides it against the page grid (which otherwise starts at the
+// layout's lower left corner), choosing whichever combination leaves the fewest pages with something drawn on them.  The
+// grid's own page count doesn't change with position much, but which of its pages are blank does.  Ties go to the
+// earlier angle and smaller shift, so an unshifted layout at the first angle is kept unless it can be beaten.
+//
+// This is a heuristic, not an exact optimum:  only the given angles are tried, and for each one the shifts are a coarse
+// grid over one page step plus the shifts that put the layout's far edge just inside a page edge, followed by a finer
+// grid around the best of those.  A placement that only works in a narrow window elsewhere can be missed.
+FlatPatternGenerator::Layout FlatPatternGenerator::PlaceLayout(const Layout& layout, const std::vector<double>& angles, ThreadPool& pool) const
+{
+	assert(!angles.empty());
+
+	// Grid origin positions to try [mm] along one direction, all within one page step
+	const unsigned int shiftCount(12);
+	auto getShifts([this, &shiftCount](const double& paperDim, const double& patternDim)
+	{
+		const double available((paperDim - 2.0 * margin) * 25.4);// [mm]
+		const double step(available - overlap * 25.4);// [mm]
+		auto wrap([&step](const double& shift)
+		{
+			return shift - step * floor(shift / step);
+		});
+
+		std::vector<double> shifts;
+		for (unsigned int i = 0; i < shiftCount; ++i)
+			shifts.push_back(i * step / shiftCount);
+
+		// Where the far edge of the layout would cross the start or the end of a page; stopping just short of it keeps
+		// the layout off the next page
+		const double clearance(1.0e-3);// [mm]
+		shifts.push_back(wrap(-patternDim - clearance));
+		shifts.push_back(wrap(available - patternDim - clearance));
+		return shifts;
+	});
+
+	auto getRefinedShifts([this, &shiftCount](const double& paperDim, const double& center)
+	{
+		const double step((paperDim - 2.0 * margin - overlap) * 25.4);// [mm]
+		const double spacing(step / (shiftCount * shiftCount));// [mm]
+		std::vector<double> shifts;
+		for (int i = -static_cast<int>(shiftCount) / 2; i <= static_cast<int>(shiftCount) / 2; ++i)
+		{
+			const double shift(center + i * spacing);
+			if (i != 0 && shift >= 0.0 && shift < step)
+				shifts.push_back(shift);
+		}
+		return shifts;
+	});
+
+	struct Placement
+	{
+		unsigned int pages;
+		double xShift;// [mm]
+		double yShift;// [mm]
+	};
+
+	std::vector<Placement> placements(angles.size());
+	pool.ParallelFor(angles.size(), [this, &layout, &angles, &getShifts, &getRefinedShifts, &placements](const std::size_t& i)
+	{
+		Layout rotated;
+		rotated.path = ShiftToZeroXandY(RotatePattern(layout.path, angles[i]));
+		rotated.outlineStart = layout.outlineStart;
+
+		Eigen::Vector2d size(Eigen::Vector2d::Zero());
+		for (const auto& p : rotated.path)
+			size = size.cwiseMax(p);
+
+		Placement& best(placements[i]);
+		best.pages = std::numeric_limits<unsigned int>::max();
+		auto tryShifts([this, &rotated, &size, &best](const std::vector<double>& xShifts, const std::vector<double>& yShifts)
+		{
+			for (const auto& xShift : xShifts)
+			{
+				for (const auto& yShift : yShifts)
+				{
+					const unsigned int pages(CountNonBlankPages(rotated, size, Eigen::Vector2d(xShift, yShift), best.pages));
+					if (pages < best.pages)
+						best = Placement{ pages, xShift, yShift };
+				}
+			}
+		});
+
+		tryShifts(getShifts(pageWidth, size(0)), getShifts(pageHeight, size(1)));
+		if (best.pages > 1)
+		{
+			auto xShifts(getRefinedShifts(pageWidth, best.xShift));
+			auto yShifts(getRefinedShifts(pageHeight, best.yShift));
+			xShifts.insert(xShifts.begin(), best.xShift);
+			yShifts.insert(yShifts.begin(), best.yShift);
+			tryShifts(xShifts, yShifts);
+		}
+	});
+
+	unsigned int best(0);
+	for (unsigned int i = 1; i < placements.size(); ++i)
+	{
+		if (placements[i].pages < placements[best].pages)
+			best = i;
+	}
+
+	Layout placed;
+	placed.path = ShiftToZeroXandY(RotatePattern(layout.path, angles[best]));
+	placed.outlineStart = layout.outlineStart;
+	for (auto& p : placed.path)
+		p += Eigen::Vector2d(placements[best].xShift, placements[best].yShift);
+
+	return placed;
+}
+
+// Count-only version of writing the pages:  a page is drawn on if any segment survives clipping to it.  The layout is
+// at the origin (size is its upper right corner) and the grid starts shift [mm] below and left of it.  Counting stops
+// at limit, since by then the placement is already no better than one that's been found.
+unsigned int FlatPatternGenerator::CountNonBlankPages(const Layout& layout, const Eigen::Vector2d& size, const Eigen::Vector2d& shift,
+	const unsigned int& limit) const
+{
+	const unsigned int xPages(CountPages(pageWidth, (size(0) + shift(0)) / 25.4));
+	const unsigned int yPages(CountPages(pageHeight, (size(1) + shift(1)) / 25.4));
+	if (xPages * yPages == 1)
+		return 1;// Single pages are centered instead
+
+	const double availableWidth(pageWidth - 2.0 * margin);// [in]
+	const double availableHeight(pageHeight - 2.0 * margin);// [in]
+	const double xStep(availableWidth - overlap);// [in]
+	const double yStep(availableHeight - overlap);// [in]
+	const Eigen::Vector2d pageSize(availableWidth * 25.4, availableHeight * 25.4);// [mm]
+
+	std::vector<bool> drawn(xPages * yPages, false);
+	unsigned int count(0);
+	for (unsigned int i = 0; i + 1 < layout.outlineStart.size(); ++i)
+	{
+		for (unsigned int segment = layout.outlineStart[i]; segment + 1 < layout.outlineStart[i + 1]; ++segment)
+		{
+			const Eigen::Vector2d p1(layout.path[segment] + shift);
+			const Eigen::Vector2d p2(layout.path[segment + 1] + shift);
+			unsigned int firstX, lastX, firstY, lastY;
+			if (!GetPageRange(std::min(p1(0), p2(0)) / 25.4, std::max(p1(0), p2(0)) / 25.4, 0.0, xStep, availableWidth, xPages, firstX, lastX) ||
+				!GetPageRange(std::min(p1(1), p2(1)) / 25.4, std::max(p1(1), p2(1)) / 25.4, 0.0, yStep, availableHeight, yPages, firstY, lastY))
+				continue;
+
+			for (unsigned int x = firstX; x <= lastX; ++x)
+			{
+				for (unsigned int y = firstY; y <= lastY; ++y)
+				{
+					if (drawn[x * yPages + y])
+						continue;
+
+					const Eigen::Vector2d lowerLeft(x * xStep * 25.4, y * yStep * 25.4);// [mm]
+					Eigen::Vector2d start, end;
+					bool startClipped, endClipped;
+					if (ClipSegment(p1, p2, Eigen::AlignedBox2d(lowerLeft, lowerLeft + pageSize), start, end, startClipped, endClipped))
+					{
+						drawn[x * yPages + y] = true;
+						if (++count >= limit)
+							return count;
+					}
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+// Pages are clipped and formatted in parallel a batch at a time, then written to the file in order, so only one batch's
+// worth of output is ever held in memory (and the buffers are reused from batch to batch).  Whether a page gets the
+// scale depends on all earlier pages being blank, which is only known once the batch is clipped, so that happens first.
+void FlatPatternGenerator::WriteTiledPages(const Layout& layout, const std::vector<PageOffset>& offsets, const unsigned int& yPages,
+	bool& scalePending, ThreadPool& pool, std::ostream& out)
+{
+	const auto index(BuildSegmentIndex(layout, offsets, yPages));
+
+	const unsigned int batchSize(4 * pool.GetThreadCount());
+	std::vector<Page> pages;
+	pages.reserve(batchSize);
+	std::vector<OutputBuffer> contents(batchSize);
+	for (unsigned int first = 0; first < offsets.size(); first += batchSize)
+	{
+		pages.clear();
+		for (unsigned int i = first; i < std::min<std::size_t>(first + batchSize, offsets.size()); ++i)
+			pages.emplace_back(offsets, i);
+
+		pool.ParallelFor(pages.size(), [this, &layout, &index, &offsets, &pages](const std::size_t& i)
+		{
+			ClipPath(layout.path, index, pages[i].index, offsets[pages[i].index], pages[i].paths);
+		});
+
+		for (auto& page : pages)
+		{
+			if (page.paths.empty())
+				continue;
+
+			page.includeScale = scalePending;
+			scalePending = false;
+		}
+
+		pool.ParallelFor(pages.size(), [this, &pages, &contents](const std::size_t& i)
+		{
+			if (pages[i].paths.empty())
+				return;
+
+			contents[i].Clear();
+			contents[i].SetPrecision(precision);
+			WritePageContent(pages[i], contents[i]);
+		});
+
+		for (unsigned int i = 0; i < pages.size(); ++i)
+		{
+			if (!pages[i].paths.empty())// Don't add blank pages
+				WritePage(contents[i].GetString(), out);
+		}
+	}
+}
+
+// Only the segments binned to this page are visited.  A piece continues from one segment to the next only if the first
+// ended unclipped and the second starts unclipped, so gaps in the segment numbers (which can't occur mid-piece anyway,
+// since a segment with an end on the page is always binned to it, and which separate one outline from the next) also
+// start a new piece.
+void FlatPatternGenerator::ClipPath(const Vector2DVectors& path, const SegmentIndex& index, const unsigned int& page,
+	const PageOffset& offset, std::vector<Vector2DVectors>& pieces) const
+{
+	const double availableWidth(pageWidth - 2.0 * margin);// [in]
+	const double availableHeight(pageHeight - 2.0 * margin);// [in]
+
+	const Eigen::Vector2d lowerLeft(offset.x * 25.4, offset.y * 25.4);// [mm]
+	const Eigen::AlignedBox2d bounds(lowerLeft, lowerLeft + Eigen::Vector2d(availableWidth * 25.4, availableHeight * 25.4));
+
+	const PageOffset offsetMM((offset.x - margin) * 25.4, (offset.y - margin) * 25.4);
+	auto toPaper([&offsetMM](const Eigen::Vector2d& p)
+	{
+		return Eigen::Vector2d(p(0) - offsetMM.x, p(1) - offsetMM.y);
+	});
+	
+	pieces.clear();
+	bool drawing(false);
+	unsigned int lastSegment(0);
+	for (unsigned int i = index.pageStart[page]; i < index.pageStart[page + 1]; ++i)
+	{
+		const unsigned int segment(index.segments[i]);
+		Eigen::Vector2d start, end;
+		bool startClipped, endClipped;
+		if (!ClipSegment(path[segment], path[segment + 1], bounds, start, end, startClipped, endClipped))
+		{
+			drawing = false;
+			continue;
+		}
+
+		if (!drawing || startClipped || segment != lastSegment + 1)
+			pieces.push_back(Vector2DVectors(1, toPaper(start)));
+		pieces.back().push_back(toPaper(end));
+
+		drawing = !endClipped;
+		lastSegment = segment;
+	}
+}
+
+// Liang-Barsky clipping against the closed rectangle.  The parameter range [t0, t1] of the segment that lies inside is
+// narrowed one axis at a time, remembering which boundary set each end so the clipped point can be placed exactly on
+// it.  Segments that only touch the rectangle at one point are rejected.
+bool FlatPatternGenerator::ClipSegment(const Eigen::Vector2d& p1, const Eigen::Vector2d& p2, const Eigen::AlignedBox2d& bounds,
+	Eigen::Vector2d& start, Eigen::Vector2d& end, bool& startClipped, bool& endClipped)
+{
+	const Eigen::Vector2d direction(p2 - p1);
+	double t0(0.0), t1(1.0);
+	int startAxis(-1), endAxis(-1);
+	double startValue(0.0), endValue(0.0);
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		const double minimum(bounds.min()(axis));
+		const double maximum(bounds.max()(axis));
+		if (direction(axis) == 0.0)
+		{
+			if (p1(axis) < minimum || p1(axis) > maximum)
+				return false;
+			continue;
+		}
+
+		const double enterValue(direction(axis) > 0.0 ? minimum : maximum);
+		const double exitValue(direction(axis) > 0.0 ? maximum : minimum);
+		const double tEnter((enterValue - p1(axis)) / direction(axis));
+		const double tExit((exitValue - p1(axis)) / direction(axis));
+		if (tEnter > t0)
+		{
+			t0 = tEnter;
+			startAxis = axis;
+			startValue = enterValue;
+		}
+
+		if (tExit < t1)
+		{
+			t1 = tExit;
+			endAxis = axis;
+			endValue = exitValue;
+		}
+	}
+
+	if (t0 > t1 || (t0 == t1 && direction != Eigen::Vector2d::Zero()))
+		return false;
+
+	// Clamping keeps the other coordinate of a clipped point from landing a rounding error outside the page
+	auto getClippedPoint([&p1, &direction, &bounds](const double& t, const int& axis, const double& value)
+	{
+		Eigen::Vector2d p(p1 + t * direction);
+		p = p.cwiseMax(bounds.min()).cwiseMin(bounds.max());
+		p(axis) = value;
+		return p;
+	});
+
+	startClipped = startAxis >= 0;
+	endClipped = endAxis >= 0;
+	start = startClipped ? getClippedPoint(t0, startAxis, startValue) : p1;
+	end = endClipped ? getClippedPoint(t1, endAxis, endValue) : p2;
+	return true;
+}
+
+// Pages lie on a regular grid, so the pages a segment's bounding box touches (including the overlap bands, which belong
+// to two pages) can be found directly from its extents
+FlatPatternGenerator::SegmentIndex FlatPatternGenerator::BuildSegmentIndex(const Layout& layout, const std::vector<PageOffset>& offsets,
+	const unsigned int& yPages) const
+{
+	const unsigned int xPages(offsets.size() / yPages);
+	const double availableWidth(pageWidth - 2.0 * margin);// [in]
+	const double availableHeight(pageHeight - 2.0 * margin);// [in]
+	const double xStep(availableWidth - overlap);// [in]
+	const double yStep(availableHeight - overlap);// [in]
+
+	const Vector2DVectors& path(layout.path);
+	auto forEachPage([&](const unsigned int& segment, const auto& function)
+	{
+		const Eigen::Vector2d& p1(path[segment]);
+		const Eigen::Vector2d& p2(path[segment + 1]);
+		unsigned int firstX, lastX, firstY, lastY;
+		if (!GetPageRange(std::min(p1(0), p2(0)) / 25.4, std::max(p1(0), p2(0)) / 25.4, offsets.front().x, xStep, availableWidth, xPages, firstX, lastX) ||
+			!GetPageRange(std::min(p1(1), p2(1)) / 25.4, std::max(p1(1), p2(1)) / 25.4, offsets.front().y, yStep, availableHeight, yPages, firstY, lastY))
+			return;
+
+		for (unsigned int x = firstX; x <= lastX; ++x)
+		{
+			for (unsigned int y = firstY; y <= lastY; ++y)
+				function(x * yPages + y);
+		}
+	});
+
+	// Count first, then fill, so each page's segments are contiguous (and in path order) in one array
+	auto forEachSegment([&layout](const auto& function)
+	{
+		for (unsigned int i = 0; i + 1 < layout.outlineStart.size(); ++i)
+		{
+			for (unsigned int segment = layout.outlineStart[i]; segment + 1 < layout.outlineStart[i + 1]; ++segment)
+				function(segment);
+		}
+	});
+
+	SegmentIndex index;
+	index.pageStart.assign(offsets.size() + 1, 0);
+	forEachSegment([&](const unsigned int& segment)
+	{
+		forEachPage(segment, [&index](const unsigned int& page) { ++index.pageStart[page + 1]; });
+	});
+
+	for (unsigned int i = 0; i < offsets.size(); ++i)
+		index.pageStart[i + 1] += index.pageStart[i];
+
+	std::vector<unsigned int> nextSlot(index.pageStart.begin(), index.pageStart.end() - 1);
+	index.segments.resize(index.pageStart.back());
+	forEachSegment([&](const unsigned int& segment)
+	{
+		forEachPage(segment, [&index, &nextSlot, &segment](const unsigned int& page) { index.segments[nextSlot[page]++] = segment; });
+	});
+
+	return index;
+}
+
+// First and last page along one direction touched by [minimum, maximum] [in]
+bool FlatPatternGenerator::GetPageRange(const double& minimum, const double& maximum, const double& base, const double& step,
+	const double& available, const unsigned int& pageCount, unsigned int& first, unsigned int& last)
+{
+	const double tolerance(1.0e-9);// [in] keeps points right at a page edge in the neighboring bin, too
+	const double firstPage(std::max(ceil((minimum - base - available) / step - tolerance), 0.0));
+	const double lastPage(std::min(floor((maximum - base) / step + tolerance), pageCount - 1.0));
+	if (firstPage > lastPage)
+		return false;
+
+	first = static_cast<unsigned int>(firstPage);
+	last = static_cast<unsigned int>(lastPage);
+	return true;
+}
+
+FlatPatternGenerator::Vector2DVectors FlatPatternGenerator::ShiftToZeroXandY(const Vector2DVectors& pattern)
+{
+	double minX(std::numeric_limits<double>::max()), minY(std::numeric_limits<double>::max());
+
+	for (const auto & p : pattern)
+	{
+		if (p(0) < minX)
+			minX = p(0);
+		if (p(1) < minY)
+			minY = p(1);
+	}
+	
+	Eigen::Vector2d shift(minX, minY);
+	
+	Vector2DVectors shifted(pattern);
+	for (auto& p : shifted)
+		p -= shift;
+	
+	return shifted;
+}
+
+void FlatPatternGenerator::DeterminePageCount(const Vector2DVectors& pattern, std::vector<PageOffset>& offsets, unsigned int& yPages) const
+{
+	double maxX(std::numeric_limits<double>::min()), maxY(std::numeric_limits<double>::min());
+
+	for (const auto & p : pattern)
+	{
+		assert(p(0) >= 0.0);
+		assert(p(1) >= 0.0);
+
+		if (p(0) > maxX)
+			maxX = p(0);
+		if (p(1) > maxY)
+			maxY = p(1);
+	}
+	
+	maxX /= 25.4;
+	maxY /= 25.4;
+
+	const unsigned int xPages(CountPages(pageWidth, maxX));
+	yPages = CountPages(pageHeight, maxY);
+
+	const double baseXOffset(xPages * yPages == 1 ? 0.5 * (maxX - pageWidth) + margin : 0.0);
+	const double baseYOffset(xPages * yPages == 1 ? 0.5 * (maxY - pageHeight) + margin : 0.0);
+
+	const double availableWidth(pageWidth - 2.0 * margin);
+	const double availableHeight(pageHeight - 2.0 * margin);
+
+	offsets.resize(xPages * yPages);
+	for (unsigned int x = 0; x < xPages; ++x)
+	{
+		for (unsigned int y = 0; y < yPages; ++y)
+		{
+			// The first page (x = 0, y = 0) will have global (0,0) at it's lower LH corner.
+			// Offsets are always equal to the location of the lower LH corner of the page with respect to global (0,0).
+			offsets[x * yPages + y].x = baseXOffset + x * (availableWidth - overlap);
+			offsets[x * yPages + y].y = baseYOffset + y * (availableHeight - overlap);
+		}
+	}
+}
+
+unsigned int FlatPatternGenerator::CountPages(const double& paperDim, const double& patternDim) const
+{
+	const auto count(static_cast<unsigned int>(ceil((patternDim - paperDim + 2.0 * margin) / (paperDim - 2.0 * margin - overlap)) + 1));
+	assert(count > 0);
+	return count;
+}
+
+// Largest pattern dimension that fits on pageCount pages (inverse of CountPages)
+double FlatPatternGenerator::GetMaxPatternDimension(const double& paperDim, const unsigned int& pageCount) const
+{
+	return paperDim - 2.0 * margin + (pageCount - 1.0) * (paperDim - 2.0 * margin - overlap);
+}
+
+// The page count depends only on the bounding box of the rotated pattern, which is set by its convex hull.  Between the
+// angles where some hull edge is aligned with the x or y axis, the same four hull vertices define the bounding box, so
+// its width and height are simple sinusoids of the rotation angle.  Each is concave over such an interval, so the fewest
+// pages are usually found at an interval end (the edge-aligned orientations).  The only other way to need fewer pages
+// is for the region where the width is small enough to overlap the region where the height is small enough somewhere
+// inside the interval, and that is checked directly.
+double FlatPatternGenerator::DetermineIdealRotationAngle(const Vector2DVectors& pattern) const
+{
+	const auto hull(ComputeConvexHull(pattern));
+	const unsigned int n(hull.size());
+	if (n < 3)
+		return 0.0;
+
+	auto countPagesAt([this, &hull](const Eigen::Vector2d& u, const Eigen::Vector2d& v)
+	{
+		double minX(std::numeric_limits<double>::max()), maxX(-minX), minY(minX), maxY(-minX);
+		for (const auto& p : hull)
+		{
+			minX = std::min(minX, u.dot(p));
+			maxX = std::max(maxX, u.dot(p));
+			minY = std::min(minY, v.dot(p));
+			maxY = std::max(maxY, v.dot(p));
+		}
+		return CountPages(pageWidth, (maxX - minX) / 25.4) * CountPages(pageHeight, (maxY - minY) / 25.4);
+	});
+
+	// Prefer a 0 or 90 deg rotation
+	unsigned int minPages(countPagesAt(Eigen::Vector2d(1.0, 0.0), Eigen::Vector2d(0.0, 1.0)));
+	double smallestAngle(0.0);// [rad]
+	const unsigned int rotatedPages(countPagesAt(Eigen::Vector2d(0.0, -1.0), Eigen::Vector2d(1.0, 0.0)));
+	if (rotatedPages < minPages)
+	{
+		minPages = rotatedPages;
+		smallestAngle = 0.5 * M_PI;
+	}
+
+	// Rotating by 180 deg doesn't change the bounding box, and rotating by 90 deg swaps its width and height, so sweeping
+	// [0, 90) deg and counting pages both ways covers every orientation.  Critical angles are kept as (cos, sin) pairs,
+	// found by turning each edge direction into the first quadrant, which avoids trigonometry for all but the rare
+	// intervals that need an interior check.
+	std::vector<Eigen::Vector2d> criticalDirections;
+	criticalDirections.reserve(n + 2);
+	criticalDirections.push_back(Eigen::Vector2d(1.0, 0.0));
+	for (unsigned int i = n; i > 0; --i)
+	{
+		// Rotating by -(edge angle) aligns the edge with the x-axis
+		const Eigen::Vector2d edge((hull[i % n] - hull[i - 1]).normalized());
+		Eigen::Vector2d direction(edge(0), -edge(1));
+		while (direction(0) <= 0.0 || direction(1) < 0.0)// Rotate by 90 deg until in [0, 90) deg
+			direction = Eigen::Vector2d(-direction(1), direction(0));
+		criticalDirections.push_back(direction);
+	}
+
+	// Edge angles increase around the hull, so walking it backward gives a few ascending runs (one per wrap past
+	// 90 deg) that can be merged instead of sorted
+	auto isBefore([](const Eigen::Vector2d& a, const Eigen::Vector2d& b)
+	{
+		return a(1) * b(0) < b(1) * a(0);// Compares tangents of the angles
+	});
+	for (auto runStart = criticalDirections.begin() + 2; runStart != criticalDirections.end(); ++runStart)
+	{
+		if (!isBefore(*runStart, *(runStart - 1)))
+			continue;
+
+		auto runEnd(runStart + 1);
+		while (runEnd != criticalDirections.end() && !isBefore(*runEnd, *(runEnd - 1)))
+			++runEnd;
+		std::inplace_merge(criticalDirections.begin() + 1, runStart, runEnd, isBefore);
+		runStart = runEnd - 1;
+	}
+	assert(std::is_sorted(criticalDirections.begin(), criticalDirections.end(), isBefore));
+	criticalDirections.push_back(Eigen::Vector2d(0.0, 1.0));
+
+	auto findExtreme([&hull](const Eigen::Vector2d& direction)
+	{
+		unsigned int index(0);
+		for (unsigned int i = 1; i < hull.size(); ++i)
+		{
+			if (direction.dot(hull[i]) > direction.dot(hull[index]))
+				index = i;
+		}
+		return index;
+	});
+
+	// Projections onto a direction are unimodal around a convex polygon, and as the sweep angle grows the directions
+	// turn clockwise, so each extreme vertex only ever moves clockwise (backward around the hull) from the last one
+	auto climb([&hull, &n](unsigned int index, const Eigen::Vector2d& direction)
+	{
+		double projection(direction.dot(hull[index]));
+		while (true)
+		{
+			const unsigned int previous(index > 0 ? index - 1 : n - 1);
+			const double previousProjection(direction.dot(hull[previous]));
+			if (previousProjection <= projection)
+				return index;
+
+			index = previous;
+			projection = previousProjection;
+		}
+	});
+
+	// Portions of [start, end] where amplitude * cos(angle - phase) <= limit (at most two, one at each end)
+	typedef std::pair<double, double> Segment;
+	auto getSegmentsBelow([](const double& amplitude, double phase, const double& limit, const double& start, const double& end)
+	{
+		std::vector<Segment> segments;
+		if (limit >= amplitude)
+		{
+			segments.push_back(Segment(start, end));
+			return segments;
+		}
+
+		const double halfWidth(acos(limit / amplitude));
+		phase += 2.0 * M_PI * std::round((0.5 * (start + end) - phase) / (2.0 * M_PI));
+		if (start <= phase - halfWidth)
+			segments.push_back(Segment(start, std::min(end, phase - halfWidth)));
+		if (phase + halfWidth <= end)
+			segments.push_back(Segment(std::max(start, phase + halfWidth), end));
+		return segments;
+	});
+
+	// Bounding box dimension [in] as a function of the sweep angle:  a * cos(angle) + b * sin(angle)
+	struct Dimension
+	{
+		Dimension(const double& _a, const double& _b, const Eigen::Vector2d& startDirection, const Eigen::Vector2d& endDirection)
+			: a(_a), b(_b), start(a * startDirection(0) + b * startDirection(1)), end(a * endDirection(0) + b * endDirection(1)) {}
+
+		double a;
+		double b;
+		double start;
+		double end;
+
+		double operator()(const double& angle) const { return a * cos(angle) + b * sin(angle); }
+		double GetAmplitude() const { return sqrt(a * a + b * b); }
+		double GetPhase() const { return atan2(b, a); }
+	};
+
+	auto toAngle([](const Eigen::Vector2d& direction)
+	{
+		return atan2(direction(1), direction(0));
+	});
+
+	// CountPages without the divisions, for screening; anything that looks like an improvement is confirmed with
+	// CountPages so rounding at exact page boundaries can't disagree with the final layout
+	struct PageEstimator
+	{
+		PageEstimator(const double& firstPage, const double& perPage) : firstPage(firstPage), pagesPerInch(1.0 / perPage) {}
+
+		const double firstPage;// [in]
+		const double pagesPerInch;// [1/in]
+
+		unsigned int operator()(const double& dimension) const
+		{
+			const double extraPages((dimension - firstPage) * pagesPerInch);
+			if (extraPages <= 0.0)
+				return 1;
+
+			const auto wholePages(static_cast<unsigned int>(extraPages));// Rounding up by hand avoids a call to ceil
+			return wholePages + (wholePages < extraPages ? 2 : 1);
+		}
+	};
+
+	const PageEstimator estimateXPages(pageWidth - 2.0 * margin, pageWidth - 2.0 * margin - overlap);
+	const PageEstimator estimateYPages(pageHeight - 2.0 * margin, pageHeight - 2.0 * margin - overlap);
+	auto checkInterval([&](const Dimension& width, const Dimension& height, const unsigned int& i, const double& angleOffset)
+	{
+		if (estimateXPages(width.start) * estimateYPages(height.start) < minPages)
+		{
+			const unsigned int startPages(CountPages(pageWidth, width.start) * CountPages(pageHeight, height.start));
+			if (startPages < minPages)
+			{
+				minPages = startPages;
+				smallestAngle = toAngle(criticalDirections[i]) + angleOffset;
+			}
+		}
+
+		// Fewest pages possible in each direction over this interval (both are smallest at one of the ends)
+		const unsigned int minXPages(estimateXPages(std::min(width.start, width.end)));
+		const unsigned int minYPages(estimateYPages(std::min(height.start, height.end)));
+		if (minXPages * minYPages >= minPages)
+			return;
+
+		const double start(toAngle(criticalDirections[i]));
+		const double end(toAngle(criticalDirections[i + 1]));
+		const double widthAmplitude(width.GetAmplitude());
+		const double heightAmplitude(height.GetAmplitude());
+		const unsigned int maxXPages(CountPages(pageWidth, widthAmplitude));
+		for (unsigned int xPages = minXPages; xPages <= maxXPages && xPages * minYPages < minPages; ++xPages)
+		{
+			const unsigned int yPages((minPages - 1) / xPages);
+			const auto widthSegments(getSegmentsBelow(widthAmplitude, width.GetPhase(), GetMaxPatternDimension(pageWidth, xPages), start, end));
+			const auto heightSegments(getSegmentsBelow(heightAmplitude, height.GetPhase(), GetMaxPatternDimension(pageHeight, yPages), start, end));
+			for (const auto& w : widthSegments)
+			{
+				for (const auto& h : heightSegments)
+				{
+					const double overlapStart(std::max(w.first, h.first));
+					const double overlapEnd(std::min(w.second, h.second));
+					if (overlapStart > overlapEnd)
+						continue;
+
+					// Middle of the overlap, to stay clear of both limits
+					const double angle(0.5 * (overlapStart + overlapEnd));
+					const unsigned int pages(CountPages(pageWidth, width(angle)) * CountPages(pageHeight, height(angle)));
+					if (pages < minPages)
+					{
+						minPages = pages;
+						smallestAngle = angle + angleOffset;
+					}
+				}
+			}
+		}
+	});
+
+	unsigned int right(findExtreme(Eigen::Vector2d(1.0, 0.0)));
+	unsigned int left(findExtreme(Eigen::Vector2d(-1.0, 0.0)));
+	unsigned int top(findExtreme(Eigen::Vector2d(0.0, 1.0)));
+	unsigned int bottom(findExtreme(Eigen::Vector2d(0.0, -1.0)));
+	for (unsigned int i = 0; i + 1 < criticalDirections.size(); ++i)
+	{
+		const Eigen::Vector2d& startDirection(criticalDirections[i]);
+		const Eigen::Vector2d& endDirection(criticalDirections[i + 1]);
+		if (startDirection(1) * endDirection(0) == endDirection(1) * startDirection(0))
+			continue;// Repeated angle
+
+		const Eigen::Vector2d middle((startDirection + endDirection).normalized());
+		const Eigen::Vector2d u(middle(0), -middle(1));// x-axis after rotation
+		const Eigen::Vector2d v(middle(1), middle(0));// y-axis after rotation
+		right = climb(right, u);
+		left = climb(left, -u);
+		top = climb(top, v);
+		bottom = climb(bottom, -v);
+
+		const Eigen::Vector2d widthSpan((hull[right] - hull[left]) / 25.4);
+		const Eigen::Vector2d heightSpan((hull[top] - hull[bottom]) / 25.4);
+
+		const Dimension width(widthSpan(0), -widthSpan(1), startDirection, endDirection);
+		const Dimension height(heightSpan(1), heightSpan(0), startDirection, endDirection);
+
+		checkInterval(width, height, i, 0.0);
+		checkInterval(height, width, i, 0.5 * M_PI);
+	}
+
+	return smallestAngle * 180.0 / M_PI;
+}
+
+// Rotations [deg] that line an edge of the pattern's convex hull up with one of the page edges, which are where the
+// bounding box (and so the page grid) changes shape.  Rotating by 180 deg only moves the layout against the grid (which
+// PlaceLayout searches anyway), so the angles are in [0, 180).
+std::vector<double> FlatPatternGenerator::GetCriticalRotationAngles(const Vector2DVectors& pattern)
+{
+	const auto hull(ComputeConvexHull(pattern));
+	std::vector<double> angles;
+	for (unsigned int i = 0; i < hull.size() && hull.size() > 1; ++i)
+	{
+		const Eigen::Vector2d edge(hull[(i + 1) % hull.size()] - hull[i]);
+		const double alignedAngle(-atan2(edge(1), edge(0)) * 180.0 / M_PI);// [deg]
+		const double angle(alignedAngle - 90.0 * floor(alignedAngle / 90.0));// [deg] in [0, 90)
+		angles.push_back(angle);
+		angles.push_back(angle + 90.0);
+	}
+
+	std::sort(angles.begin(), angles.end());
+	const double tolerance(1.0e-9);// [deg]
+	angles.erase(std::unique(angles.begin(), angles.end(), [&tolerance](const double& a, const double& b)
+	{
+		return b - a < tolerance;
+	}), angles.end());
+	return angles;
+}
+
+// Melkman's algorithm, which runs in linear time because the points are an outline (a simple polyline, open or
+// closed) rather than an arbitrary set; returns the hull counter-clockwise
+FlatPatternGenerator::Vector2DVectors FlatPatternGenerator::ComputeConvexHull(const Vector2DVectors& points)
+{
+	Vector2DVectors outline;
+	outline.reserve(points.size());
+	for (const auto& p : points)
+	{
+		if (outline.empty() || p != outline.back())
+			outline.push_back(p);
+	}
+
+	if (outline.size() > 1 && outline.front() == outline.back())
+		outline.pop_back();
+
+	auto cross([](const Eigen::Vector2d& o, const Eigen::Vector2d& a, const Eigen::Vector2d& b)
+	{
+		return (a(0) - o(0)) * (b(1) - o(1)) - (a(1) - o(1)) * (b(0) - o(0));
+	});
+
+	// Leading points in line with the first one lie along a single segment (the outline can't double back on itself)
+	unsigned int first(2);
+	while (first < outline.size() && cross(outline[0], outline[first - 1], outline[first]) == 0.0)
+		++first;
+	if (first >= outline.size())
+		return outline;
+
+	// Deque stored in an array with room to grow in both directions; the bottom and top entries are always the most
+	// recently added point
+	Vector2DVectors deque(2 * outline.size() + 1);
+	unsigned int bottom(outline.size()), top(bottom + 3);
+	deque[bottom] = outline[first];
+	deque[top] = outline[first];
+	if (cross(outline[0], outline[first - 1], outline[first]) > 0.0)
+	{
+		deque[bottom + 1] = outline[0];
+		deque[bottom + 2] = outline[first - 1];
+	}
+	else
+	{
+		deque[bottom + 1] = outline[first - 1];
+		deque[bottom + 2] = outline[0];
+	}
+
+	for (unsigned int i = first + 1; i < outline.size(); ++i)
+	{
+		const Eigen::Vector2d& p(outline[i]);
+		if (cross(deque[top - 1], deque[top], p) > 0.0 && cross(deque[bottom], deque[bottom + 1], p) > 0.0)
+			continue;// Inside the current hull
+
+		while (cross(deque[top - 1], deque[top], p) <= 0.0)
+			--top;
+		deque[++top] = p;
+
+		while (cross(p, deque[bottom], deque[bottom + 1]) <= 0.0)
+			++bottom;
+		deque[--bottom] = p;
+	}
+
+	return Vector2DVectors(deque.begin() + bottom, deque.begin() + top);
+}
+
+FlatPatternGenerator::Vector2DVectors FlatPatternGenerator::RotatePattern(const Vector2DVectors& pattern, const double& angle)
+{
+	const auto rotation(Eigen::Rotation2D<double>(angle * M_PI / 180.0));
+	Vector2DVectors rotated(pattern.size());
+	for (unsigned int i = 0; i < pattern.size(); ++i)
+		rotated[i] = rotation * pattern[i];
+
+	return rotated;
+}
+
+std::vector<FlatPatternGenerator::AlignmentMark> FlatPatternGenerator::GetAlignmentMarks() const
+{
+	const double edgeOffset(margin + 0.5 * overlap);
+	const double markSize(0.3);// [in]
+
+	std::vector<AlignmentMark> marks(4);
+	marks[0].center = PageOffset(edgeOffset, edgeOffset);
+	marks[0].rotation = MarkRotation::Normal;
+	marks[1].center = PageOffset(pageWidth - edgeOffset, edgeOffset);
+	marks[1].rotation = MarkRotation::Rotated;
+	marks[2].center = PageOffset(edgeOffset, pageHeight - edgeOffset);
+	marks[2].rotation = MarkRotation::Rotated;
+	marks[3].center = PageOffset(pageWidth - edgeOffset, pageHeight - edgeOffset);
+	marks[3].rotation = MarkRotation::Normal;
+	for (auto& m : marks)
+		m.radius = 0.5 * markSize * 25.4;
+
+	return marks;
+}
+
+FlatPatternGenerator::PageMatrix FlatPatternGenerator::GetPageMatrix(const std::vector<PageOffset>& offsets, const PageOffset& currentOffset) const
+{
+	assert(offsets.size() > 1);
+
+	PageMatrix matrix;
+	matrix.origin = PageOffset(margin + overlap, margin);// TODO:  Position such that the pattern cannot overlap
+
+	double maxX(0.0);// [in]
+	double maxY(0.0);// [in]
+	std::vector<double> exes, wyes;
+	for (const auto& o : offsets)
+	{
+		exes.push_back(o.x);
+		wyes.push_back(o.y);
+
+		if (o.x > maxX)
+			maxX = o.x;
+		if (o.y > maxY)
+			maxY = o.y;
+	}
+
+	auto getSpacing([](std::vector<double>& values)
+	{
+		std::sort(values.begin(), values.end());
+		values.erase(std::unique(values.begin(), values.end()), values.end());
+		if (values.size() > 1)
+			return values[1] - values[0];
+		return 0.0;
+	});
+
+	double deltaX(getSpacing(exes));
+	double deltaY(getSpacing(wyes));
+
+	if (deltaX == 0.0)
+	{
+		assert(deltaY > 0.0);
+		deltaX = deltaY * pageWidth / pageHeight;
+	}
+	if (deltaY == 0.0)
+	{
+		assert(deltaX > 0.0);
+		deltaY = deltaX * pageHeight / pageWidth;
+	}
+
+	maxX += deltaX;// [in]
+	maxY += deltaY;// [in]
+	maxX *= 25.4;// now [mm]
+	maxY *= 25.4;// now [mm]
+
+	deltaX *= 25.4;// now [mm]
+	deltaY *= 25.4;// now [mm]
+
+	double scale;
+	const double largestMatrixDimension(overlap * 25.4);// [mm] - dimension chosen as overlap to ensure this only appers within the overlap region
+	if (maxX > maxY)
+		scale = largestMatrixDimension / maxX;
+	else
+		scale = largestMatrixDimension / maxY;
+
+	matrix.cellWidth = deltaX * scale;
+	matrix.cellHeight = deltaY * scale;
+	matrix.width = maxX * scale;
+	matrix.height = maxY * scale;
+	matrix.currentLowerLeft = Eigen::Vector2d(currentOffset.x * 25.4 * scale, currentOffset.y * 25.4 * scale);
+	matrix.currentUpperRight = Eigen::Vector2d((currentOffset.x * 25.4 + deltaX) * scale, (currentOffset.y * 25.4 + deltaY) * scale);
+
+	return matrix;
+}
@@ -0,0 +1,182 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  flatPatternGenerator.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Base class for printable flat pattern writers.  Handles rotating the pattern, splitting it into pages and
+//        clipping it to each page, leaving only the file format to derived classes.
+
+#ifndef FLAT_PATTERN_GENERATOR_H_
+#define FLAT_PATTERN_GENERATOR_H_
+
+// Local headers
+#include "outputBuffer.h"
+
+// Eigen headers
+#include <Eigen/Eigen>
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <ostream>
+#include <limits>
+
+// Local forward declarations
+class ThreadPool;
+
+class FlatPatternGenerator
+{
+public:
+	typedef std::vector<Eigen::Vector2d, Eigen::aligned_allocator<Eigen::Vector2d>> Vector2DVectors;
+
+	virtual ~FlatPatternGenerator() = default;
+
+	inline void SetMargin(const double& m) { margin = m; }
+	inline void SetOverlap(const double& o) { overlap = o; }
+	inline void SetPageSize(const double& w, const double& h) { pageWidth = w; pageHeight = h; }
+	inline void SetNestingGap(const double& g) { nestingGap = g; }
+	inline void SetThreadCount(const unsigned int& count) { threadCount = count; }
+	inline void SetPrecision(const unsigned int& p) { precision = p; }
+
+	// Shape is the closed outline in [mm]
+	bool WriteFlatPatterns(const Vector2DVectors& shape, const std::string& fileName);
+
+	enum class NestingTarget
+	{
+		FewestPages,// One layout, tiled across pages like a single outline
+		StockSheets// Each page is a separate sheet of stock, filled without tiling (no scale or alignment marks)
+	};
+
+	// Packs copies of the shape together (see GoreNester) instead of writing just one
+	bool WriteNestedFlatPatterns(const Vector2DVectors& shape, const unsigned int& copies, const NestingTarget& target, const std::string& fileName);
+
+protected:
+	struct PageOffset
+	{
+		PageOffset() = default;
+		PageOffset(const double& _x, const double& _y) : x(_x), y(_y) {}
+
+		double x;// [in]
+		double y;// [in]
+	};
+
+	// Everything to draw on one (non-blank) page.  Coordinates are [mm] from the lower left corner of the paper.
+	struct Page
+	{
+		Page(const std::vector<PageOffset>& offsets, const unsigned int& index) : offsets(offsets), index(index) {}
+
+		const std::vector<PageOffset>& offsets;// All pages, for the page matrix
+		const unsigned int index;
+		std::vector<Vector2DVectors> paths;// Pieces of the outline that fall on this page
+		bool includeScale = false;
+	};
+
+	// Writers produce each page's content independently (into a buffer), then place it in the file in order.  Content
+	// for several pages is generated at once on different threads.  Page buffers are set to the [mm] precision.
+	virtual void WriteHeader(std::ostream& out) = 0;
+	virtual void WritePageContent(const Page& page, OutputBuffer& out) const = 0;
+	virtual void WritePage(const std::string& content, std::ostream& out) = 0;
+	virtual void WriteFooter(std::ostream& out) = 0;
+
+	double margin = 0.5;// [in]
+	double overlap = 0.75;// [in]
+
+	double pageWidth = 17.0;// [in]
+	double pageHeight = 11.0;// [in]
+
+	double nestingGap = 0.125;// [in] between nested copies
+
+	unsigned int threadCount = 0;// Zero for one per core
+
+	unsigned int precision = 2;// Digits after the decimal point for [mm] values (0.01 mm)
+	unsigned int GetInchPrecision() const { return precision + 2; }// Slightly finer than the [mm] resolution
+
+	// Registration marks in the overlap bands, used to line up neighboring pages
+	enum class MarkRotation
+	{
+		Normal,// Filled quadrants are the upper right and lower left
+		Rotated// Filled quadrants are the upper left and lower right
+	};
+
+	struct AlignmentMark
+	{
+		PageOffset center;
+		MarkRotation rotation;
+		double radius;// [mm]
+	};
+
+	std::vector<AlignmentMark> GetAlignmentMarks() const;
+
+	// Small map of the page layout with the current page filled in, drawn at origin; sizes are [mm]
+	struct PageMatrix
+	{
+		PageOffset origin;
+		double cellWidth;
+		double cellHeight;
+		double width;
+		double height;
+
+		Eigen::Vector2d currentLowerLeft;
+		Eigen::Vector2d currentUpperRight;
+	};
+
+	PageMatrix GetPageMatrix(const std::vector<PageOffset>& offsets, const PageOffset& currentOffset) const;
+
+	// Scale check drawn on the first page, as a path [mm] starting from GetScaleOrigin()
+	static const Vector2DVectors scaleMark;
+	PageOffset GetScaleOrigin() const { return PageOffset(margin, 2 * overlap); }
+
+private:
+	// Closed outlines joined into one path, each ending with a repeat of its first point
+	struct Layout
+	{
+		Vector2DVectors path;
+		std::vector<unsigned int> outlineStart;// Where each outline begins in path (plus one past the end)
+	};
+
+	static Layout JoinOutlines(const std::vector<Vector2DVectors>& outlines);
+	void WriteTiledPages(const Layout& layout, const std::vector<PageOffset>& offsets, const unsigned int& yPages, bool& scalePending,
+		ThreadPool& pool, std::ostream& out);
+
+	// Rotated and shifted for the fewest non-blank pages; the result is ready for DeterminePageCount
+	Layout PlaceLayout(const Layout& layout, const std::vector<double>& angles, ThreadPool& pool) const;
+	unsigned int CountNonBlankPages(const Layout& layout, const Eigen::Vector2d& size, const Eigen::Vector2d& shift,
+		const unsigned int& limit = std::numeric_limits<unsigned int>::max()) const;
+
+	// Outline segments (segment i runs from point i to point i + 1, but never from one outline to the next) binned by
+	// the pages they touch
+	struct SegmentIndex
+	{
+		std::vector<unsigned int> pageStart;// Where each page's entries begin in segments (plus one past the end)
+		std::vector<unsigned int> segments;
+	};
+
+	void DeterminePageCount(const Vector2DVectors& pattern, std::vector<PageOffset>& offsets, unsigned int& yPages) const;
+	SegmentIndex BuildSegmentIndex(const Layout& layout, const std::vector<PageOffset>& offsets, const unsigned int& yPages) const;
+	static bool GetPageRange(const double& minimum, const double& maximum, const double& base, const double& step,
+		const double& available, const unsigned int& pageCount, unsigned int& first, unsigned int& last);
+	unsigned int CountPages(const double& paperDim, const double& patternDim) const;
+	double GetMaxPatternDimension(const double& paperDim, const unsigned int& pageCount) const;
+
+	void ClipPath(const Vector2DVectors& path, const SegmentIndex& index, const unsigned int& page, const PageOffset& offset, std::vector<Vector2DVectors>& pieces) const;
+
+	static Vector2DVectors ShiftToZeroXandY(const Vector2DVectors& pattern);
+
+	double DetermineIdealRotationAngle(const Vector2DVectors& pattern) const;
+	static std::vector<double> GetCriticalRotationAngles(const Vector2DVectors& pattern);
+	static Vector2DVectors RotatePattern(const Vector2DVectors& pattern, const double& angle);
+	static Vector2DVectors ComputeConvexHull(const Vector2DVectors& points);
+
+	// Portion of the segment p1-p2 inside bounds (false if there's none); the flags are set where an end was moved
+	static bool ClipSegment(const Eigen::Vector2d& p1, const Eigen::Vector2d& p2, const Eigen::AlignedBox2d& bounds,
+		Eigen::Vector2d& start, Eigen::Vector2d& end, bool& startClipped, bool& endClipped);
+};
+
+#endif// FLAT_PATTERN_GENERATOR_H_
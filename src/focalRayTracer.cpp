@@ -0,0 +1,143 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  focalRayTracer.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Monte Carlo ray tracing of on-axis sound reflected by a faceted dish.
+
+// Local headers
+#include "focalRayTracer.h"
+#include "threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cmath>
+
+const std::size_t FocalRayTracer::raysPerBlock(65536);
+
+FocalRayTracer::Results FocalRayTracer::Trace(const std::size_t& rayCount, const double& micRadius, const std::uint64_t& seed) const
+{
+	std::vector<Tally> blocks(GetBlockCount(rayCount));
+	ThreadPool pool(threadCount);
+	pool.ParallelForBlocks(rayCount, blocks.size(), [this, &blocks, &micRadius, &seed](const std::size_t& begin, const std::size_t& end, const std::size_t& block)
+	{
+		auto generator(CreateGenerator(seed, block));
+		blocks[block] = TraceRays(surface, end - begin, micRadius, generator);
+	});
+
+	return Summarize(blocks);
+}
+
+FocalRayTracer::Results FocalRayTracer::Trace(const FacetedSurface& surface, const std::size_t& rayCount, const double& micRadius, const std::uint64_t& seed)
+{
+	// Same blocks as the parallel version, so the answers match exactly
+	std::vector<Tally> blocks(GetBlockCount(rayCount));
+	const std::size_t blockSize(rayCount / std::max<std::size_t>(blocks.size(), 1));
+	const std::size_t remainder(rayCount % std::max<std::size_t>(blocks.size(), 1));
+	for (std::size_t i = 0; i < blocks.size(); ++i)
+	{
+		auto generator(CreateGenerator(seed, i));
+		blocks[i] = TraceRays(surface, blockSize + (i < remainder ? 1 : 0), micRadius, generator);
+	}
+
+	return Summarize(blocks);
+}
+
+std::size_t FocalRayTracer::GetBlockCount(const std::size_t& rayCount)
+{
+	return (rayCount + raysPerBlock - 1) / raysPerBlock;
+}
+
+std::mt19937_64 FocalRayTracer::CreateGenerator(const std::uint64_t& seed, const std::size_t& block)
+{
+	std::seed_seq sequence({ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+		static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(static_cast<std::uint64_t>(block) >> 32) });
+	return std::mt19937_64(sequence);
+}
+
+FocalRayTracer::Tally FocalRayTracer::TraceRays(const FacetedSurface& surface, const std::size_t& rayCount, const double& micRadius, std::mt19937_64& generator)
+{
+	// Uniform doubles in [0, 1) from the top 53 bits (std::uniform_real_distribution differs between standard libraries)
+	auto uniform([&generator]()
+	{
+		return static_cast<double>(generator() >> 11) * 0x1.0p-53;
+	});
+
+	const auto& info(surface.GetParabolaInfo());
+	const double rimRadius(0.5 * info.diameter);
+	const double wedgeHalfWidthPerRadius(tan(M_PI / info.facetCount));
+	const Eigen::Vector3d incident(0.0, 0.0, -1.0);
+	const Eigen::Vector3d focus(0.0, 0.0, info.focusPosition);
+
+	Tally tally;
+	tally.rayCount = rayCount;
+	for (std::size_t i = 0; i < rayCount; ++i)
+	{
+		// The aperture is a polygon made of one triangular wedge per gore, all with equal area
+		const auto gore(static_cast<unsigned int>(uniform() * info.facetCount) % info.facetCount);
+		const double xLocal(rimRadius * sqrt(uniform()));
+		const double yLocal(xLocal * wedgeHalfWidthPerRadius * (2.0 * uniform() - 1.0));
+		const Eigen::Vector2d aperturePoint(surface.FromGoreFrame(gore, xLocal, yLocal));
+
+		Eigen::Vector3d point, normal;
+		if (!surface.GetSurfacePoint(aperturePoint.x(), aperturePoint.y(), point, normal))
+			continue;
+		++tally.hitCount;
+
+		const Eigen::Vector3d reflected(incident - 2.0 * incident.dot(normal) * normal);
+		const Eigen::Vector3d toFocus(focus - point);
+		double radius;
+		if (toFocus.dot(reflected) > 0.0)
+			radius = toFocus.cross(reflected).norm();
+		else// Reflected away from the focus
+			radius = toFocus.norm();
+
+		tally.sumRadius += radius;
+		tally.sumSquaredRadius += radius * radius;
+		tally.maxRadius = std::max(tally.maxRadius, radius);
+		if (radius <= micRadius)
+			++tally.capturedCount;
+	}
+
+	return tally;
+}
+
+void FocalRayTracer::Tally::Add(const Tally& t)
+{
+	rayCount += t.rayCount;
+	hitCount += t.hitCount;
+	capturedCount += t.capturedCount;
+	sumRadius += t.sumRadius;
+	sumSquaredRadius += t.sumSquaredRadius;
+	maxRadius = std::max(maxRadius, t.maxRadius);
+}
+
+FocalRayTracer::Results FocalRayTracer::Summarize(const std::vector<Tally>& blocks)
+{
+	// Combined in block order so the floating point sums don't depend on which thread finished first
+	Tally total;
+	for (const auto& block : blocks)
+		total.Add(block);
+
+	Results results;
+	results.rayCount = total.rayCount;
+	results.hitCount = total.hitCount;
+	results.maxSpotRadius = total.maxRadius;
+	if (total.hitCount > 0)
+	{
+		results.meanSpotRadius = total.sumRadius / total.hitCount;
+		results.rmsSpotRadius = sqrt(total.sumSquaredRadius / total.hitCount);
+	}
+
+	if (total.rayCount > 0)
+		results.capturedFraction = static_cast<double>(total.capturedCount) / total.rayCount;
+
+	return results;
+}
@@ -0,0 +1,82 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  focalRayTracer.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Monte Carlo ray tracing of on-axis sound reflected by a faceted dish.
+
+#ifndef FOCAL_RAY_TRACER_H_
+#define FOCAL_RAY_TRACER_H_
+
+// Local headers
+#include "facetedSurface.h"
+
+// Standard C++ headers
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+class FocalRayTracer
+{
+public:
+	explicit FocalRayTracer(const ParabolaCalculator::ParabolaInfo& info) : surface(info) {}
+
+	// Spot radius is the distance by which each reflected ray misses the focus (closest approach), for rays that strike
+	// a gore.  Unlike the intercept with the focal plane, this stays meaningful for rays that leave a deep dish nearly
+	// parallel to that plane.
+	struct Results
+	{
+		std::size_t rayCount = 0;
+		std::size_t hitCount = 0;// Rays that struck a gore (the rest fell between gores)
+
+		double rmsSpotRadius = 0.0;// [in]
+		double meanSpotRadius = 0.0;// [in]
+		double maxSpotRadius = 0.0;// [in]
+
+		double capturedFraction = 0.0;// [-] fraction of all rays passing within the microphone radius of the focus
+	};
+
+	// Rays are spread uniformly over the aperture.  Work is split into fixed blocks, each with its own random
+	// stream derived from seed and the block index, so results depend only on the arguments and not on the number
+	// of threads.
+	Results Trace(const std::size_t& rayCount, const double& micRadius, const std::uint64_t& seed = 0) const;
+
+	// Same result as above, but entirely on the calling thread, for callers that are already running in parallel
+	static Results Trace(const FacetedSurface& surface, const std::size_t& rayCount, const double& micRadius, const std::uint64_t& seed = 0);
+
+	// Zero threads means "use one thread per core"
+	void SetThreadCount(const unsigned int& count) { threadCount = count; }
+
+private:
+	const FacetedSurface surface;
+	unsigned int threadCount = 0;
+
+	static const std::size_t raysPerBlock;
+
+	struct Tally
+	{
+		std::size_t rayCount = 0;
+		std::size_t hitCount = 0;
+		std::size_t capturedCount = 0;
+		double sumRadius = 0.0;
+		double sumSquaredRadius = 0.0;
+		double maxRadius = 0.0;
+
+		void Add(const Tally& t);
+	};
+
+	static std::size_t GetBlockCount(const std::size_t& rayCount);
+	static std::mt19937_64 CreateGenerator(const std::uint64_t& seed, const std::size_t& block);
+	static Tally TraceRays(const FacetedSurface& surface, const std::size_t& rayCount, const double& micRadius, std::mt19937_64& generator);
+	static Results Summarize(const std::vector<Tally>& blocks);
+};
+
+#endif// FOCAL_RAY_TRACER_H_
@@ -0,0 +1,50 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  gCodeGenerator.cpp
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Writes outlines as a G-code cutting program.  Each outline is cut in one pass, starting and ending at its
+//        first point, with the tool switched on only while cutting.
+
+// Local headers
+#include "gCodeGenerator.h"
+
+void GCodeGenerator::WriteHeader(const unsigned int& /*sheetCount*/, const unsigned int& /*pathCount*/, OutputBuffer& out)
+{
+	out << "(Parabolic Design App flat patterns)\n"
+		<< "G21\n"// [mm]
+		<< "G90\n"// Absolute coordinates
+		<< "M5\n";
+}
+
+// The program pauses before each sheet after the first so the next one can be loaded
+void GCodeGenerator::BeginSheet(const unsigned int& sheet, OutputBuffer& out)
+{
+	out << "(Sheet " << sheet + 1 << ")\n";
+	if (sheet > 0)
+		out << "G0 X0 Y0\nM0\n";
+}
+
+void GCodeGenerator::WritePath(const Vector2DVectors& path, const unsigned int& /*sheet*/, OutputBuffer& out)
+{
+	out << "G0 X" << path.front()(0) << " Y" << path.front()(1) << '\n'
+		<< "M3 S" << toolPower << '\n'
+		<< "G1 F" << feedRate << '\n';
+	for (unsigned int i = 1; i < path.size(); ++i)
+		out << "G1 X" << path[i](0) << " Y" << path[i](1) << '\n';
+	out << "G1 X" << path.front()(0) << " Y" << path.front()(1) << '\n'
+		<< "M5\n";
+}
+
+void GCodeGenerator::WriteFooter(OutputBuffer& out)
+{
+	out << "G0 X0 Y0\n"
+		<< "M2\n";
+}
@@ -0,0 +1,43 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  gCodeGenerator.h
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Writes outlines as a G-code cutting program.  Each outline is cut in one pass, starting and ending at its
+//        first point, with the tool switched on only while cutting.
+
+#ifndef G_CODE_GENERATOR_H_
+#define G_CODE_GENERATOR_H_
+
+// Local headers
+#include "cutPathGenerator.h"
+
+class GCodeGenerator : public CutPathGenerator
+{
+public:
+	inline void SetFeedRate(const double& f) { feedRate = f; }// [mm/min]
+
+	// The tool is switched with spindle commands, which fire the beam on a GRBL-style laser.  The power is the S word
+	// given with every M3, since a bare M3 reuses the last S value and GRBL resets that to zero (its default range is
+	// 0 to 1000).
+	inline void SetToolPower(const double& s) { toolPower = s; }
+
+protected:
+	void WriteHeader(const unsigned int& sheetCount, const unsigned int& pathCount, OutputBuffer& out) override;
+	void BeginSheet(const unsigned int& sheet, OutputBuffer& out) override;
+	void WritePath(const Vector2DVectors& path, const unsigned int& sheet, OutputBuffer& out) override;
+	void WriteFooter(OutputBuffer& out) override;
+
+private:
+	double feedRate = 1000.0;// [mm/min]
+	double toolPower = 1000.0;// [-] spindle speed units
+};
+
+#endif// G_CODE_GENERATOR_H_
@@ -0,0 +1,68 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  gaussLegendre.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Gauss-Legendre quadrature nodes and weights.
+
+// Local headers
+#include "gaussLegendre.h"
+
+// Standard C++ headers
+#include <cmath>
+
+namespace GaussLegendre
+{
+
+Rule GetRule(const unsigned int& order, const double& a, const double& b)
+{
+	Rule rule;
+	rule.node.resize(order);
+	rule.weight.resize(order);
+
+	const double halfWidth(0.5 * (b - a));
+	const double center(0.5 * (a + b));
+
+	// Roots are symmetric, so only compute half of them.  Each root of P_n is found by Newton
+	// iteration from a Chebyshev-like initial guess, evaluating P_n with the three-term recurrence.
+	const unsigned int halfCount((order + 1) / 2);
+	for (unsigned int i = 0; i < halfCount; ++i)
+	{
+		double x(cos(M_PI * (i + 0.75) / (order + 0.5)));
+		double derivative(1.0);
+		for (unsigned int iteration = 0; iteration < 100; ++iteration)
+		{
+			double p0(1.0), p1(0.0);
+			for (unsigned int j = 1; j <= order; ++j)
+			{
+				const double p2(p1);
+				p1 = p0;
+				p0 = ((2.0 * j - 1.0) * x * p1 - (j - 1.0) * p2) / j;
+			}
+
+			// p0 = P_n(x), p1 = P_(n-1)(x)
+			derivative = order * (x * p0 - p1) / (x * x - 1.0);
+			const double step(p0 / derivative);
+			x -= step;
+			if (fabs(step) < 1.0e-15)
+				break;
+		}
+
+		const double w(2.0 / ((1.0 - x * x) * derivative * derivative));
+		rule.node[i] = center - halfWidth * x;
+		rule.node[order - 1 - i] = center + halfWidth * x;
+		rule.weight[i] = halfWidth * w;
+		rule.weight[order - 1 - i] = halfWidth * w;
+	}
+
+	return rule;
+}
+
+}// namespace GaussLegendre
@@ -0,0 +1,36 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  gaussLegendre.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Gauss-Legendre quadrature nodes and weights.
+
+#ifndef GAUSS_LEGENDRE_H_
+#define GAUSS_LEGENDRE_H_
+
+// Standard C++ headers
+#include <vector>
+
+namespace GaussLegendre
+{
+
+struct Rule
+{
+	std::vector<double> node;
+	std::vector<double> weight;
+};
+
+// Rule with the specified number of points for integrating over [a, b].
+// Exact for polynomials of degree up to 2 * order - 1.
+Rule GetRule(const unsigned int& order, const double& a = -1.0, const double& b = 1.0);
+
+}// namespace GaussLegendre
+
+#endif// GAUSS_LEGENDRE_H_
@@ -0,0 +1,338 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  goreNester.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Packs several copies of one outline into a compact layout.  Copies are stacked in strips, alternately turned
+//        by 180 deg and staggered so the wide end of one fits beside the narrow end of the next.
+
+// Local headers
+#include "goreNester.h"
+#include "threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <limits>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+// Stagger is searched in steps of one bin, over half the outline's length in either direction
+const unsigned int GoreNester::binCount(512);
+
+GoreNester::GoreNester(const Vector2DVectors& outline, const double& gap) : gap(gap)
+{
+	for (unsigned int quarterTurn = 0; quarterTurn < 2; ++quarterTurn)
+	{
+		Vector2DVectors turned(outline);
+		if (quarterTurn == 1)
+		{
+			for (auto& p : turned)
+				p = Eigen::Vector2d(-p(1), p(0));
+		}
+
+		Vector2DVectors flipped(turned);
+		for (auto& p : flipped)
+			p = -p;
+
+		profiles[quarterTurn][0] = BuildProfile(turned);
+		profiles[quarterTurn][1] = BuildProfile(flipped);
+	}
+}
+
+GoreNester::Profile GoreNester::BuildProfile(const Vector2DVectors& shape) const
+{
+	assert(shape.size() > 1);
+
+	Eigen::Vector2d minimum(shape.front()), maximum(shape.front());
+	for (const auto& p : shape)
+	{
+		minimum = minimum.cwiseMin(p);
+		maximum = maximum.cwiseMax(p);
+	}
+
+	Profile profile;
+	profile.shape = shape;
+	for (auto& p : profile.shape)
+		p -= minimum;
+
+	profile.width = maximum(0) - minimum(0);
+	profile.height = maximum(1) - minimum(1);
+	assert(profile.width > 0.0);
+	profile.binWidth = profile.width / binCount;
+
+	const double infinity(std::numeric_limits<double>::infinity());
+	profile.lower.assign(binCount, infinity);
+	profile.upper.assign(binCount, -infinity);
+
+	// Each segment's extents within a bin are found at the ends of the part that lies in the bin
+	auto getBin([&profile](const double& x)
+	{
+		return std::min(static_cast<unsigned int>(x / profile.binWidth), binCount - 1);
+	});
+
+	for (unsigned int i = 0; i < profile.shape.size(); ++i)
+	{
+		const Eigen::Vector2d& p1(profile.shape[i]);
+		const Eigen::Vector2d& p2(profile.shape[(i + 1) % profile.shape.size()]);
+		const double left(std::min(p1(0), p2(0)));
+		const double right(std::max(p1(0), p2(0)));
+		for (unsigned int bin = getBin(left); bin <= getBin(right); ++bin)
+		{
+			double y1(p1(1)), y2(p2(1));
+			if (p1(0) != p2(0))
+			{
+				const double slope((p2(1) - p1(1)) / (p2(0) - p1(0)));
+				y1 = p1(1) + slope * (std::max(left, bin * profile.binWidth) - p1(0));
+				y2 = p1(1) + slope * (std::min(right, (bin + 1) * profile.binWidth) - p1(0));
+			}
+
+			profile.lower[bin] = std::min(profile.lower[bin], std::min(y1, y2));
+			profile.upper[bin] = std::max(profile.upper[bin], std::max(y1, y2));
+		}
+	}
+
+	profile.dilationRadius = static_cast<unsigned int>(ceil(gap / profile.binWidth));
+	profile.dilatedUpper.assign(binCount + 2 * profile.dilationRadius, -infinity);
+	for (unsigned int bin = 0; bin < binCount; ++bin)
+	{
+		for (unsigned int i = bin; i <= bin + 2 * profile.dilationRadius; ++i)
+			profile.dilatedUpper[i] = std::max(profile.dilatedUpper[i], profile.upper[bin]);
+	}
+
+	return profile;
+}
+
+// Smallest vertical distance [mm] between the shapes' origins that keeps the gap when above is shifted right by stagger
+// bins relative to below; negative infinity if they never come within the gap of each other
+double GoreNester::GetSeparation(const Profile& below, const Profile& above, const int& stagger) const
+{
+	double separation(-std::numeric_limits<double>::infinity());
+	const int dilatedBinCount(static_cast<int>(below.dilatedUpper.size()));
+	for (int bin = 0; bin < static_cast<int>(binCount); ++bin)
+	{
+		const int dilatedBin(bin + stagger + static_cast<int>(below.dilationRadius));
+		if (dilatedBin < 0 || dilatedBin >= dilatedBinCount)
+			continue;
+
+		separation = std::max(separation, below.dilatedUpper[dilatedBin] - above.lower[bin]);
+	}
+
+	return separation + gap;
+}
+
+std::vector<GoreNester::Candidate> GoreNester::GetCandidates() const
+{
+	std::vector<Candidate> candidates;
+	for (unsigned int quarterTurn = 0; quarterTurn < 2; ++quarterTurn)
+	{
+		for (unsigned int flipped = 0; flipped < 2; ++flipped)
+		{
+			const int maxStagger(static_cast<int>(binCount / 2));
+			for (int stagger = -maxStagger; stagger <= maxStagger; ++stagger)
+			{
+				Candidate c;
+				c.quarterTurn = quarterTurn == 1;
+				c.flipped = flipped == 1;
+				c.stagger = stagger;
+				candidates.push_back(c);
+			}
+		}
+	}
+
+	return candidates;
+}
+
+// Each copy is placed as low as it can go without coming within the gap of any copy below it
+std::vector<double> GoreNester::StackCopies(const Candidate& candidate, const unsigned int& count) const
+{
+	const Profile& even(profiles[candidate.quarterTurn][0]);
+	const Profile& odd(profiles[candidate.quarterTurn][candidate.flipped ? 1 : 0]);
+
+	// [lower copy is odd][upper copy is odd]; pairs with the same parity are directly above each other
+	const double separation[2][2] = {
+		{ GetSeparation(even, even, 0), GetSeparation(even, odd, candidate.stagger) },
+		{ GetSeparation(odd, even, -candidate.stagger), GetSeparation(odd, odd, 0) } };
+
+	std::vector<double> y(count, 0.0);
+	for (unsigned int i = 1; i < count; ++i)
+	{
+		y[i] = y[i - 1];
+		for (unsigned int j = 0; j < i; ++j)
+			y[i] = std::max(y[i], y[j] + separation[j % 2][i % 2]);
+	}
+
+	return y;
+}
+
+double GoreNester::GetStripWidth(const Candidate& candidate, const unsigned int& count) const
+{
+	const Profile& profile(profiles[candidate.quarterTurn][0]);
+	if (count < 2)
+		return profile.width;
+	return profile.width + std::abs(candidate.stagger) * profile.binWidth;
+}
+
+bool GoreNester::Arrangement::IsBetterThan(const Arrangement& a) const
+{
+	if (sheets == 0)
+		return false;// Doesn't fit
+	if (a.sheets == 0)
+		return true;
+	if (sheets != a.sheets)
+		return sheets < a.sheets;
+	return area < a.area;
+}
+
+// Candidates are independent, so they're spread across threads; the serial reduction keeps the earliest of equally good
+// arrangements so the result doesn't depend on the thread count
+template<typename Evaluate>
+GoreNester::Arrangement GoreNester::FindBestArrangement(const std::vector<Candidate>& candidates, const Evaluate& evaluate) const
+{
+	std::vector<Arrangement> arrangements(candidates.size());
+	ThreadPool pool(threadCount);
+	pool.ParallelFor(candidates.size(), [&candidates, &evaluate, &arrangements](const std::size_t& i)
+	{
+		arrangements[i] = evaluate(candidates[i]);
+		arrangements[i].candidate = i;
+	});
+
+	Arrangement best(arrangements.front());
+	for (const auto& a : arrangements)
+	{
+		if (a.IsBetterThan(best))
+			best = a;
+	}
+
+	return best;
+}
+
+std::vector<GoreNester::Vector2DVectors> GoreNester::NestForFewestSheets(const unsigned int& copies, const SheetCounter& countSheets) const
+{
+	if (copies == 0)
+		return std::vector<Vector2DVectors>();
+
+	auto evaluate([this, &copies, &countSheets](const Candidate& candidate)
+	{
+		const auto y(StackCopies(candidate, copies));
+		const double height(profiles[candidate.quarterTurn][0].height);
+
+		Arrangement best;
+		for (unsigned int perColumn = 1; perColumn <= copies; ++perColumn)
+		{
+			Arrangement a;
+			a.perColumn = perColumn;
+			a.columns = (copies + perColumn - 1) / perColumn;
+
+			const double layoutWidth(a.columns * GetStripWidth(candidate, perColumn) + (a.columns - 1) * gap);
+			const double layoutHeight(y[perColumn - 1] + height);
+			a.area = layoutWidth * layoutHeight;
+			for (unsigned int rotated = 0; rotated < 2; ++rotated)
+			{
+				a.rotated = rotated == 1;
+				a.sheets = a.rotated ? countSheets(layoutHeight, layoutWidth) : countSheets(layoutWidth, layoutHeight);
+				if (a.IsBetterThan(best))
+					best = a;
+			}
+		}
+
+		return best;
+	});
+
+	const auto candidates(GetCandidates());
+	const auto best(FindBestArrangement(candidates, evaluate));
+	return PlaceCopies(candidates[best.candidate], best.perColumn, copies, best.rotated);
+}
+
+std::vector<std::vector<GoreNester::Vector2DVectors>> GoreNester::NestOnSheets(const unsigned int& copies, const double& sheetWidth, const double& sheetHeight) const
+{
+	std::vector<std::vector<Vector2DVectors>> sheets;
+	if (copies == 0)
+		return sheets;
+
+	auto evaluate([this, &copies, &sheetWidth, &sheetHeight](const Candidate& candidate)
+	{
+		const auto y(StackCopies(candidate, copies));
+		const double height(profiles[candidate.quarterTurn][0].height);
+
+		Arrangement best;
+		for (unsigned int rotated = 0; rotated < 2; ++rotated)
+		{
+			// Strips run along the sheet's height unless the layout is turned
+			const double availableWidth(rotated == 1 ? sheetHeight : sheetWidth);
+			const double availableHeight(rotated == 1 ? sheetWidth : sheetHeight);
+			for (unsigned int perColumn = 1; perColumn <= copies && y[perColumn - 1] + height <= availableHeight; ++perColumn)
+			{
+				const double stripWidth(GetStripWidth(candidate, perColumn));
+				const auto columnsThatFit(static_cast<unsigned int>((availableWidth + gap) / (stripWidth + gap)));
+				if (columnsThatFit == 0)
+					continue;
+
+				Arrangement a;
+				a.rotated = rotated == 1;
+				a.perColumn = perColumn;
+				a.columns = std::min(columnsThatFit, (copies + perColumn - 1) / perColumn);
+				a.sheets = (copies + perColumn * a.columns - 1) / (perColumn * a.columns);
+				a.area = (a.columns * stripWidth + (a.columns - 1) * gap) * (y[perColumn - 1] + height);
+				if (a.IsBetterThan(best))
+					best = a;
+			}
+		}
+
+		return best;
+	});
+
+	const auto candidates(GetCandidates());
+	const auto best(FindBestArrangement(candidates, evaluate));
+	if (best.sheets == 0)
+		return sheets;
+
+	const unsigned int perSheet(best.perColumn * best.columns);
+	for (unsigned int placed = 0; placed < copies; placed += perSheet)
+		sheets.push_back(PlaceCopies(candidates[best.candidate], best.perColumn, std::min(perSheet, copies - placed), best.rotated));
+
+	return sheets;
+}
+
+// Fills columns of perColumn copies from left to right, then moves the lower left corner of the result to the origin
+std::vector<GoreNester::Vector2DVectors> GoreNester::PlaceCopies(const Candidate& candidate, const unsigned int& perColumn,
+	const unsigned int& count, const bool& rotated) const
+{
+	const Profile& even(profiles[candidate.quarterTurn][0]);
+	const Profile& odd(profiles[candidate.quarterTurn][candidate.flipped ? 1 : 0]);
+	const auto y(StackCopies(candidate, std::min(perColumn, count)));
+
+	const double stagger(candidate.stagger * even.binWidth);// [mm]
+	const double columnPitch(GetStripWidth(candidate, perColumn) + gap);// [mm]
+
+	std::vector<Vector2DVectors> outlines(count);
+	Eigen::Vector2d minimum(Eigen::Vector2d::Constant(std::numeric_limits<double>::max()));
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const unsigned int row(i % perColumn);
+		const Eigen::Vector2d shift((i / perColumn) * columnPitch + (row % 2 == 1 ? stagger : 0.0), y[row]);
+		outlines[i] = row % 2 == 1 ? odd.shape : even.shape;
+		for (auto& p : outlines[i])
+		{
+			p += shift;
+			if (rotated)
+				p = Eigen::Vector2d(-p(1), p(0));
+			minimum = minimum.cwiseMin(p);
+		}
+	}
+
+	for (auto& outline : outlines)
+	{
+		for (auto& p : outline)
+			p -= minimum;
+	}
+
+	return outlines;
+}
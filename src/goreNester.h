@@ -0,0 +1,109 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  goreNester.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Packs several copies of one outline into a compact layout.  Copies are stacked in strips, alternately turned
+//        by 180 deg and staggered so the wide end of one fits beside the narrow end of the next.
+
+#ifndef GORE_NESTER_H_
+#define GORE_NESTER_H_
+
+// Eigen headers
+#include <Eigen/Eigen>
+
+// Standard C++ headers
+#include <vector>
+#include <functional>
+
+class GoreNester
+{
+public:
+	typedef std::vector<Eigen::Vector2d, Eigen::aligned_allocator<Eigen::Vector2d>> Vector2DVectors;
+
+	// Outline is closed and in [mm]; at least gap [mm] is left between neighboring copies
+	GoreNester(const Vector2DVectors& outline, const double& gap);
+
+	void SetThreadCount(const unsigned int& count) { threadCount = count; }
+
+	// Number of sheets needed to print a layout of the given size [mm]
+	typedef std::function<unsigned int(const double& width, const double& height)> SheetCounter;
+
+	// All copies in a single layout (lower left corner at the origin) needing the fewest sheets; ties go to the layout
+	// with the smallest area.  The counter is called from several threads at once.
+	std::vector<Vector2DVectors> NestForFewestSheets(const unsigned int& copies, const SheetCounter& countSheets) const;
+
+	// Copies split across as few sheets with the given usable size [mm] as possible, one layout per sheet.  Empty if a
+	// single copy doesn't fit on a sheet.
+	std::vector<std::vector<Vector2DVectors>> NestOnSheets(const unsigned int& copies, const double& sheetWidth, const double& sheetHeight) const;
+
+private:
+	static const unsigned int binCount;
+
+	const double gap;// [mm]
+	unsigned int threadCount = 0;
+
+	// Vertical extents of a shape within equal-width slices of its x-range, used to find how closely two shapes can be
+	// stacked.  The bins always bound the true outline, so stacked copies can't overlap.
+	struct Profile
+	{
+		Vector2DVectors shape;// Lower left corner at the origin
+		double width;// [mm]
+		double height;// [mm]
+		double binWidth;// [mm]
+
+		std::vector<double> lower;
+		std::vector<double> upper;
+
+		// Upper extents widened by the gap on either side (dilationRadius bins), so copies side by side keep the gap, too
+		unsigned int dilationRadius;
+		std::vector<double> dilatedUpper;
+	};
+
+	// [quarterTurn][flipped]; the second shape is the first turned by 180 deg
+	Profile profiles[2][2];
+
+	Profile BuildProfile(const Vector2DVectors& shape) const;
+	double GetSeparation(const Profile& below, const Profile& above, const int& stagger) const;
+
+	// One way of forming the strips:  odd copies are shifted by stagger bins along the strip, and use the flipped shape
+	// if requested
+	struct Candidate
+	{
+		bool quarterTurn;// Outline turned by 90 deg before stacking
+		bool flipped;
+		int stagger;
+	};
+
+	std::vector<Candidate> GetCandidates() const;
+	std::vector<double> StackCopies(const Candidate& candidate, const unsigned int& count) const;// [mm] y-position of each copy
+	double GetStripWidth(const Candidate& candidate, const unsigned int& count) const;// [mm]
+
+	// Strips of perColumn copies side by side, turned by 90 deg as a whole if rotated
+	struct Arrangement
+	{
+		unsigned int candidate;
+		bool rotated = false;
+		unsigned int perColumn = 0;
+		unsigned int columns = 0;
+
+		unsigned int sheets = 0;
+		double area = 0.0;// [mm^2]
+
+		bool IsBetterThan(const Arrangement& a) const;
+	};
+
+	template<typename Evaluate>
+	Arrangement FindBestArrangement(const std::vector<Candidate>& candidates, const Evaluate& evaluate) const;
+
+	std::vector<Vector2DVectors> PlaceCopies(const Candidate& candidate, const unsigned int& perColumn, const unsigned int& count, const bool& rotated) const;
+};
+
+#endif// GORE_NESTER_H_
@@ -14,11 +14,15 @@
 
 // Standard C++ headers
 #include <algorithm>
+#include <memory>
 
 // Local headers
 #include "mainFrame.h"
 #include "parabolicDesignApp.h"
 #include "latexGenerator.h"
+#include "pdfGenerator.h"
+#include "dxfGenerator.h"
+#include "gCodeGenerator.h"
 
 // LibPlot2D headers
 #include <lp2d/renderer/plotRenderer.h>
@@ -64,7 +68,16 @@ const unsigned long long MainFrame::mHighQualityCurvePointLimit(10000);
 //
 //==========================================================================
 MainFrame::MainFrame() : wxFrame(nullptr, wxID_ANY, wxEmptyString,
-	wxDefaultPosition, wxDefaultSize, wxDEFAULT_FRAME_STYLE), mShapePlotInterface(this), mResponsePlotInterface(this)
+	wxDefaultPosition, wxDefaultSize, wxDEFAULT_FRAME_STYLE), mShapePlotInterface(this), mResponsePlotInterface(this),
+	calculationWorker(calculationCache, [this](const std::shared_ptr<const CalculationCache::Results>& results, const unsigned long long& requestId)
+	{
+		// Controls may only be touched from the UI thread; anything superseded by the time this runs is dropped
+		CallAfter([this, results, requestId]()
+		{
+			if (calculationWorker.IsLatest(requestId))
+				DisplayResults(*results);
+		});
+	})
 {
 	CreateControls();
 	SetProperties();
@@ -204,6 +217,32 @@ wxSizer* MainFrame::CreateTextInputs(wxWindow* parent)
 	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("(in)")));
 	paperHeightText->SetValidator(wxFloatingPointValidator<double>(3, &paperHeight, wxNUM_VAL_NO_TRAILING_ZEROES));
 
+	cutterKerfText = new wxTextCtrl(sizer->GetStaticBox(), wxID_ANY);
+	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("Cutter Kerf")));
+	subSizer->Add(cutterKerfText);
+	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("(mm)")));
+	cutterKerfText->SetValidator(wxFloatingPointValidator<double>(3, &cutterKerf, wxNUM_VAL_NO_TRAILING_ZEROES));
+
+	feedRateText = new wxTextCtrl(sizer->GetStaticBox(), wxID_ANY);
+	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("Feed Rate")));
+	subSizer->Add(feedRateText);
+	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("(mm/min)")));
+	feedRateText->SetValidator(wxFloatingPointValidator<double>(1, &feedRate, wxNUM_VAL_NO_TRAILING_ZEROES));
+
+	laserPowerText = new wxTextCtrl(sizer->GetStaticBox(), wxID_ANY);
+	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("Laser Power")));
+	subSizer->Add(laserPowerText);
+	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("(S value)")));
+	laserPowerText->SetValidator(wxFloatingPointValidator<double>(1, &laserPower, wxNUM_VAL_NO_TRAILING_ZEROES));
+
+	// Order must match the handling in OnWriteShapeClicked
+	const wxString layoutChoices[] = { _T("Single Gore"), _T("All Gores, Fewest Pages"), _T("All Gores, Paper is Stock Sheet") };
+	templateLayoutChoice = new wxChoice(sizer->GetStaticBox(), wxID_ANY, wxDefaultPosition, wxDefaultSize, 3, layoutChoices);
+	templateLayoutChoice->SetSelection(0);
+	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("Template Layout")));
+	subSizer->Add(templateLayoutChoice);
+	subSizer->AddStretchSpacer();
+
 	return sizer;
 }
 
@@ -238,6 +277,10 @@ wxSizer* MainFrame::CreateTextOutputs(wxWindow* parent)
 	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("Max. Design Error")));
 	subSizer->Add(maxDesignErrorText);
 
+	rmsSurfaceErrorText = new wxStaticText(sizer->GetStaticBox(), wxID_ANY, dummyQuantity);
+	subSizer->Add(new wxStaticText(sizer->GetStaticBox(), wxID_ANY, _T("RMS Surface Error")));
+	subSizer->Add(rmsSurfaceErrorText);
+
 	return sizer;
 }
 
@@ -371,22 +414,64 @@ void MainFrame::TextChangedEvent(wxCommandEvent& WXUNUSED(event))
 //==========================================================================
 void MainFrame::OnWriteShapeClicked(wxCommandEvent& WXUNUSED(event))
 {
+	TransferDataFromWindow();// Paper and cutter inputs don't trigger an update when edited
 	calculator.SetParabolaInfo(parabolaInfo);
 	
-	wxFileDialog dialog(this, _T("Save As"), wxEmptyString, wxEmptyString, _T("LaTeX Source (*.tex)|*.tex"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+	wxFileDialog dialog(this, _T("Save As"), wxEmptyString, wxEmptyString, _T("LaTeX Source (*.tex)|*.tex|PDF (*.pdf)|*.pdf|DXF (*.dxf)|*.dxf|G-code (*.nc)|*.nc"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
 	if (dialog.ShowModal() == wxID_CANCEL)
 		return;
 		
 	std::string fileName(dialog.GetPath().ToStdString());
 	
-	const unsigned int pointCount(2000);
-	auto pattern(calculator.GetFacetShape(pointCount));
-	for (auto& p : pattern)// LaTeX generator expects mm, so do the conversion
+	const double maxOutlineDeviation(0.01 / 25.4);// [in] well below what can be cut by hand
+	double achievedDeviation;
+	auto pattern(calculator.GetAdaptiveFacetShape(maxOutlineDeviation, achievedDeviation));
+	for (auto& p : pattern)// Pattern generators expect mm, so do the conversion
 		p *= 25.4;
 	
-	LaTeXGenerator generator;
-	generator.SetPageSize(paperWidth, paperHeight);
-	if (!generator.WriteFlatPatterns(pattern, fileName))
+	bool written;
+	const int layout(templateLayoutChoice->GetSelection());
+	if (dialog.GetFilterIndex() >= 2)
+	{
+		// Cutting machines get whole outlines; with the stock sheet layout, the paper size is the machine's sheet size
+		std::unique_ptr<CutPathGenerator> generator;
+		if (dialog.GetFilterIndex() == 2)
+			generator = std::make_unique<DXFGenerator>();
+		else
+		{
+			auto gCodeGenerator(std::make_unique<GCodeGenerator>());
+			gCodeGenerator->SetFeedRate(feedRate);
+			gCodeGenerator->SetToolPower(laserPower);
+			generator = std::move(gCodeGenerator);
+		}
+
+		generator->SetKerf(cutterKerf);
+		if (layout == 2)
+			generator->SetSheetSize(paperWidth, paperHeight);
+
+		if (layout == 0)
+			written = generator->WriteOutline(pattern, fileName);
+		else
+			written = generator->WriteNestedOutlines(pattern, parabolaInfo.facetCount, fileName);
+	}
+	else
+	{
+		std::unique_ptr<FlatPatternGenerator> generator;
+		if (dialog.GetFilterIndex() == 1)
+			generator = std::make_unique<PDFGenerator>();
+		else
+			generator = std::make_unique<LaTeXGenerator>();
+
+		generator->SetPageSize(paperWidth, paperHeight);
+		if (layout == 1)
+			written = generator->WriteNestedFlatPatterns(pattern, parabolaInfo.facetCount, FlatPatternGenerator::NestingTarget::FewestPages, fileName);
+		else if (layout == 2)
+			written = generator->WriteNestedFlatPatterns(pattern, parabolaInfo.facetCount, FlatPatternGenerator::NestingTarget::StockSheets, fileName);
+		else
+			written = generator->WriteFlatPatterns(pattern, fileName);
+	}
+
+	if (!written)
 		wxMessageBox(_T("Failed to write template to '") + fileName + _T("'"));
 }
 
@@ -401,16 +486,23 @@ void MainFrame::UpdateCalculations()
 		parabolaInfo.focusPosition <= 0.0)
 		return;
 
-	calculator.SetParabolaInfo(parabolaInfo);
+	CalculationCache::Request request;
+	request.info = parabolaInfo;
+	request.shapePointCount = 500;
+	request.maxFrequency = 20000.0;// [Hz]
+	request.responseTolerance = 0.05;// [dB]
+	calculationWorker.Submit(request);// Results come back through DisplayResults
+}
 
-	depthText->SetLabel(wxString::Format(_T("%0.2f in"), calculator.GetParabolaDepth()));
-	maxDesignErrorText->SetLabel(wxString::Format(_T("%0.2f in"), calculator.GetMaxDesignError()));
+void MainFrame::DisplayResults(const CalculationCache::Results& results)
+{
+	depthText->SetLabel(wxString::Format(_T("%0.2f in"), results.depth));
+	maxDesignErrorText->SetLabel(wxString::Format(_T("%0.2f in"), results.maxDesignError));
+	rmsSurfaceErrorText->SetLabel(wxString::Format(_T("%0.2f in"), results.rmsSurfaceError));
 
-	const unsigned int pointCount(500);
-	const double maxFrequency(20000.0);
-	auto parabolaShape(calculator.GetParabolaShape(pointCount));
-	const auto facetShape(calculator.GetFacetShape(pointCount));
-	const auto frequencyResponse(calculator.GetResponse(pointCount, maxFrequency));
+	const auto& parabolaShape(results.parabolaShape);
+	const auto& facetShape(results.facetShape);
+	const auto& frequencyResponse(results.response);
 
 	mShapePlotInterface.ClearAllCurves();
 	mResponsePlotInterface.ClearAllCurves();
@@ -425,36 +517,28 @@ void MainFrame::UpdateCalculations()
 	mResponsePlotArea->SetLeftYLabel(_T("Gain (dB)"));
 	mResponsePlotArea->SetTitle(_T("Frequency Response"));
 	
-	double minParabolaY(std::numeric_limits<double>::max());
-	double maxParabolaY(std::numeric_limits<double>::min());
-	double maxFacetY(std::numeric_limits<double>::min());
-	for (unsigned int i = 0; i < pointCount; ++i)
-	{
-		if (parabolaShape[i](1) < minParabolaY)
-			minParabolaY = parabolaShape[i](1);
-		if (parabolaShape[i](1) > maxParabolaY)
-			maxParabolaY = parabolaShape[i](1);
-		if (facetShape[i](1) > maxFacetY)
-			maxFacetY = facetShape[i](1);
-	}
+	const auto parabolaYRange(std::minmax_element(parabolaShape.y.begin(), parabolaShape.y.end()));
+	const double minParabolaY(*parabolaYRange.first);
+	const double maxParabolaY(*parabolaYRange.second);
+	const double maxFacetY(*std::max_element(facetShape.y.begin(), facetShape.y.end()));
 
+	// Offset is applied while copying into the dataset, so the cached curve is never modified
 	const double offset(maxFacetY - minParabolaY + 0.1 * (maxParabolaY - minParabolaY));
-	for (auto& p : parabolaShape)
-		p(1) += offset;
 
-	mShapePlotInterface.AddCurve(std::move(ConvertToDataset(parabolaShape)), _T("Parabola Shape"));
+	mShapePlotInterface.AddCurve(std::move(ConvertToDataset(parabolaShape, offset)), _T("Parabola Shape"));
 	mShapePlotInterface.AddCurve(std::move(ConvertToDataset(facetShape)), _T("Facet Shape"));
 	mResponsePlotInterface.AddCurve(std::move(ConvertToDataset(frequencyResponse)), _T("Frequency Response"));
+	mResponsePlotInterface.AddCurve(std::move(ConvertToDataset(results.builtResponse)), _T("Built Dish Response"));
 }
 
-std::unique_ptr<LibPlot2D::Dataset2D> MainFrame::ConvertToDataset(const ParabolaCalculator::Vector2DVectors& v)
+std::unique_ptr<LibPlot2D::Dataset2D> MainFrame::ConvertToDataset(const CalculationCache::Curve& c, const double& yOffset)
 {
-	auto d(std::make_unique<LibPlot2D::Dataset2D>(v.size()));
-	for (unsigned int i = 0; i < v.size(); ++i)
-	{
-		d->GetX()[i] = v[i](0);
-		d->GetY()[i] = v[i](1);
-	}
-	
+	auto d(std::make_unique<LibPlot2D::Dataset2D>(c.x.size()));
+	std::copy(c.x.begin(), c.x.end(), d->GetX().begin());
+	if (yOffset == 0.0)
+		std::copy(c.y.begin(), c.y.end(), d->GetY().begin());
+	else
+		std::transform(c.y.begin(), c.y.end(), d->GetY().begin(), [&yOffset](const double& y) { return y + yOffset; });
+
 	return d;
 }
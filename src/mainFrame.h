@@ -17,6 +17,8 @@
 
 // Local headers
 #include "parabolaCalculator.h"
+#include "calculationCache.h"
+#include "calculationWorker.h"
 
 // LibPlot2D headers
 #include <lp2d/gui/guiInterface.h>
@@ -57,10 +59,17 @@ private:
 	
 	ParabolaCalculator calculator;
 	ParabolaCalculator::ParabolaInfo parabolaInfo;
+	CalculationCache calculationCache;// Avoids recomputing when the user returns to a recent design
+	CalculationWorker calculationWorker;// Keeps typing responsive; must be declared after the cache it uses
 	
 	double paperWidth = 11.0;// [in]
 	double paperHeight = 14.0;// [in]
 
+	// For cutting machine output
+	double cutterKerf = 0.0;// [mm]
+	double feedRate = 1000.0;// [mm/min]
+	double laserPower = 1000.0;// [-] G-code S value
+
 	// Controls
 	wxTextCtrl* diameterText;
 	wxTextCtrl* focusPositionText;
@@ -68,9 +77,15 @@ private:
 	
 	wxTextCtrl* paperHeightText;
 	wxTextCtrl* paperWidthText;
+	wxChoice* templateLayoutChoice;
+
+	wxTextCtrl* cutterKerfText;
+	wxTextCtrl* feedRateText;
+	wxTextCtrl* laserPowerText;
 
 	wxStaticText* depthText;
 	wxStaticText* maxDesignErrorText;
+	wxStaticText* rmsSurfaceErrorText;
 
 	LibPlot2D::PlotRenderer *mShapePlotArea;
 	LibPlot2D::PlotRenderer *mResponsePlotArea;
@@ -86,9 +101,10 @@ private:
 	void OnWriteShapeClicked(wxCommandEvent& event);
 
 	void UpdateCalculations();
+	void DisplayResults(const CalculationCache::Results& results);
 	bool initialized = false;
 	
-	static std::unique_ptr<LibPlot2D::Dataset2D> ConvertToDataset(const ParabolaCalculator::Vector2DVectors& v);
+	static std::unique_ptr<LibPlot2D::Dataset2D> ConvertToDataset(const CalculationCache::Curve& c, const double& yOffset = 0.0);
 
 	DECLARE_EVENT_TABLE();
 };
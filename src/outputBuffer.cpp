@@ -0,0 +1,55 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  outputBuffer.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Reusable text buffer for generated files.  Numbers are formatted with std::to_chars, so the output doesn't
+//        depend on the locale, and doubles are written with a fixed number of decimal places (trailing zeros dropped).
+
+// Local headers
+#include "outputBuffer.h"
+
+// Standard C++ headers
+#include <limits>
+#include <cassert>
+
+OutputBuffer& OutputBuffer::Append(const double& value, const unsigned int& digits)
+{
+	auto appendTrimmed([this, &digits](const char* begin, const char* end)
+	{
+		if (digits > 0)
+		{
+			while (*(end - 1) == '0')
+				--end;
+			if (*(end - 1) == '.')
+				--end;
+		}
+
+		if (end - begin == 2 && begin[0] == '-' && begin[1] == '0')
+			++begin;// Values that round to zero are written the same regardless of sign
+
+		buffer.append(begin, end);
+	});
+
+	char text[64];
+	const auto result(std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, digits));
+	if (result.ec == std::errc())
+	{
+		appendTrimmed(text, result.ptr);
+		return *this;
+	}
+
+	// Only huge values (or lots of digits) need more room
+	std::string large(std::numeric_limits<double>::max_exponent10 + digits + 4, '\0');
+	const auto largeResult(std::to_chars(&large[0], &large[0] + large.size(), value, std::chars_format::fixed, digits));
+	assert(largeResult.ec == std::errc());
+	appendTrimmed(large.data(), largeResult.ptr);
+	return *this;
+}
@@ -0,0 +1,67 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  outputBuffer.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Reusable text buffer for generated files.  Numbers are formatted with std::to_chars, so the output doesn't
+//        depend on the locale, and doubles are written with a fixed number of decimal places (trailing zeros dropped).
+
+#ifndef OUTPUT_BUFFER_H_
+#define OUTPUT_BUFFER_H_
+
+// Standard C++ headers
+#include <string>
+#include <ostream>
+#include <charconv>
+#include <type_traits>
+
+class OutputBuffer
+{
+public:
+	explicit OutputBuffer(const unsigned int& precision = 2) : precision(precision) {}
+
+	// Digits after the decimal point
+	inline void SetPrecision(const unsigned int& p) { precision = p; }
+	inline unsigned int GetPrecision() const { return precision; }
+
+	OutputBuffer& Append(const double& value, const unsigned int& digits);
+
+	OutputBuffer& operator<<(const double& value) { return Append(value, precision); }
+	OutputBuffer& operator<<(const char* text) { buffer.append(text); return *this; }
+	OutputBuffer& operator<<(const std::string& text) { buffer.append(text); return *this; }
+	OutputBuffer& operator<<(const char& c) { buffer.push_back(c); return *this; }
+
+	template<typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value, int>::type = 0>
+	OutputBuffer& operator<<(const T& value);
+
+	// Empties the buffer, but keeps its memory for the next use
+	inline void Clear() { buffer.clear(); }
+	inline const std::string& GetString() const { return buffer; }
+
+private:
+	unsigned int precision;
+	std::string buffer;
+};
+
+template<typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value, int>::type>
+OutputBuffer& OutputBuffer::operator<<(const T& value)
+{
+	char text[24];// Enough for any 64-bit integer
+	const auto result(std::to_chars(text, text + sizeof(text), value));
+	buffer.append(text, result.ptr);
+	return *this;
+}
+
+inline std::ostream& operator<<(std::ostream& out, const OutputBuffer& buffer)
+{
+	return out.write(buffer.GetString().data(), buffer.GetString().size());
+}
+
+#endif// OUTPUT_BUFFER_H_
@@ -14,11 +14,15 @@
 
 // Local headers
 #include "parabolaCalculator.h"
+#include "responseKernel.h"
+#include "reflectorProfile.h"
 
 // Standard C++ headers
 #include <cassert>
+#include <algorithm>
 
 const double ParabolaCalculator::speedOfSound(13503.937008);// [in/sec]
+const double ParabolaCalculator::minResponseFrequency(100.0);// [Hz] something small enough to show the low-frequency response without making the x-axis scaling unnecessarily tight
 
 // Removed after updating gain plot, which shows there may be some minimial amplification at low
 // frequencies.  Better not to state this explicitly and allow the user to see the effect on the
@@ -30,24 +34,154 @@ const double ParabolaCalculator::speedOfSound(13503.937008);// [in/sec]
 	return speedOfSound / parabolaInfo.diameter;// [Hz]
 }*/
 
-double ParabolaCalculator::GetParabolaDepth() const
+ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetResponse(const unsigned int& pointCount, const double& maxFrequency, const FrequencySpacing& spacing) const
 {
-	return parabolaInfo.diameter * parabolaInfo.diameter * 0.0625 / parabolaInfo.focusPosition;
+	const auto frequency(GetResponseFrequencies(pointCount, maxFrequency, spacing));
+	std::vector<double> gain(pointCount);
+	ComputeResponse(frequency.data(), gain.data(), pointCount);
+	return Interleave(frequency, gain);
 }
 
-double ParabolaCalculator::GetMaxDesignError() const
+void ParabolaCalculator::GetResponse(const unsigned int& pointCount, const double& maxFrequency, const FrequencySpacing& spacing, double* frequency, double* gain) const
 {
-	// The design creates the desired parabola along the center of each facet.  So the
-	// largest error will be at the widest part of the parabola, were two facets join.
-	// We'll report the error in a plane perpendicular to the axis of the parabola.
-	
-	const double halfFacetWidth(0.5 * M_PI * parabolaInfo.diameter / parabolaInfo.facetCount);
-	const double jointDistance(sqrt(parabolaInfo.diameter * parabolaInfo.diameter * 0.25 + halfFacetWidth * halfFacetWidth));
+	GetResponseFrequencies(pointCount, maxFrequency, spacing, frequency);
+	ComputeResponse(frequency, gain, pointCount);
+}
+
+ParabolaCalculator::Vector2DVectors ParabolaCalculator::Interleave(const std::vector<double>& x, const std::vector<double>& y)
+{
+	assert(x.size() == y.size());
+	Vector2DVectors v(x.size());
+	for (unsigned int i = 0; i < x.size(); ++i)
+	{
+		v[i](0) = x[i];
+		v[i](1) = y[i];
+	}
 
-	return jointDistance - 0.5 * parabolaInfo.diameter;
+	return v;
 }
-	
-ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetResponse(const unsigned int& pointCount, const double& maxFrequency) const
+
+std::vector<double> ParabolaCalculator::GetResponseFrequencies(const unsigned int& pointCount, const double& maxFrequency, const FrequencySpacing& spacing)
+{
+	std::vector<double> frequency(pointCount);
+	GetResponseFrequencies(pointCount, maxFrequency, spacing, frequency.data());
+	return frequency;
+}
+
+void ParabolaCalculator::GetResponseFrequencies(const unsigned int& pointCount, const double& maxFrequency, const FrequencySpacing& spacing, double* frequency)
+{
+	if (spacing == FrequencySpacing::Logarithmic)
+	{
+		const double ratio(pow(maxFrequency / minResponseFrequency, 1.0 / (pointCount - 1)));
+		frequency[0] = minResponseFrequency;
+		for (unsigned int i = 1; i < pointCount; ++i)
+			frequency[i] = frequency[i - 1] * ratio;
+		frequency[pointCount - 1] = maxFrequency;// Avoid accumulated rounding at the end
+	}
+	else
+	{
+		const double frequencyStep((maxFrequency - minResponseFrequency) / (pointCount - 1));
+		for (unsigned int i = 0; i < pointCount; ++i)
+			frequency[i] = minResponseFrequency + i * frequencyStep;
+	}
+}
+
+ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetAdaptiveResponse(const double& maxFrequency, const double& tolerance, const unsigned int& maxPointCount) const
+{
+	std::vector<double> frequency, gain;
+	GetAdaptiveResponse(maxFrequency, tolerance, frequency, gain, maxPointCount);
+	return Interleave(frequency, gain);
+}
+
+void ParabolaCalculator::GetAdaptiveResponse(const double& maxFrequency, const double& tolerance, std::vector<double>& frequency, std::vector<double>& gain, const unsigned int& maxPointCount) const
+{
+	// The ripple comes from sin(4 * pi * a / lambda), which has a period of c / (2 * a) in frequency.
+	// Seed with a coarse log-spaced grid, then split any interval longer than a quarter of the ripple
+	// period so that no peak or notch can fall entirely between two samples.
+	const unsigned int seedCount(25);
+	const double ripplePeriod(0.5 * speedOfSound / parabolaInfo.focusPosition);// [Hz]
+	const auto coarse(GetResponseFrequencies(seedCount, maxFrequency, FrequencySpacing::Logarithmic));
+	frequency.clear();
+	for (unsigned int i = 0; i + 1 < coarse.size(); ++i)
+	{
+		const unsigned int divisions(static_cast<unsigned int>(ceil((coarse[i + 1] - coarse[i]) / (0.25 * ripplePeriod))));
+		const double ratio(pow(coarse[i + 1] / coarse[i], 1.0 / divisions));
+		double f(coarse[i]);
+		for (unsigned int j = 0; j < divisions; ++j, f *= ratio)
+			frequency.push_back(f);
+	}
+	frequency.push_back(coarse.back());
+
+	gain.resize(frequency.size());
+	ComputeResponse(frequency.data(), gain.data(), static_cast<unsigned int>(frequency.size()));
+
+	// Interval i spans points i and i + 1; only intervals flagged as active are tested on each pass.
+	// Each active interval is tested at its two interior third-points (in log-frequency), since a single midpoint
+	// can land on the straight line even when a notch sits to one side of it.  Test points for all active intervals
+	// are evaluated together so each pass is one call to the vectorized kernel.  Every test point is kept, so once the
+	// remaining budget can't cover all active intervals, only the first ones that fit are tested (the last pass).
+	std::vector<bool> active(frequency.size() - 1, true);
+	std::vector<bool> tested(active.size());
+	std::vector<double> testFrequency, testGain;
+	while (frequency.size() + 2 <= maxPointCount)
+	{
+		testFrequency.clear();
+		for (unsigned int i = 0; i < active.size(); ++i)
+		{
+			tested[i] = active[i] && frequency.size() + testFrequency.size() + 2 <= maxPointCount;
+			if (!tested[i])
+				continue;
+
+			const double thirdRatio(cbrt(frequency[i + 1] / frequency[i]));
+			testFrequency.push_back(frequency[i] * thirdRatio);
+			testFrequency.push_back(testFrequency.back() * thirdRatio);
+		}
+
+		if (testFrequency.empty())
+			break;
+
+		testGain.resize(testFrequency.size());
+		ComputeResponse(testFrequency.data(), testGain.data(), static_cast<unsigned int>(testFrequency.size()));
+
+		std::vector<double> newFrequency, newGain;
+		std::vector<bool> newActive;
+		newFrequency.reserve(frequency.size() + testFrequency.size());
+		newGain.reserve(newFrequency.capacity());
+		newActive.reserve(newFrequency.capacity());
+
+		unsigned int test(0);
+		for (unsigned int i = 0; i < active.size(); ++i)
+		{
+			newFrequency.push_back(frequency[i]);
+			newGain.push_back(gain[i]);
+			if (!tested[i])
+			{
+				newActive.push_back(active[i]);
+				continue;
+			}
+
+			const double error(std::max(fabs(testGain[test] - (2.0 * gain[i] + gain[i + 1]) / 3.0),
+				fabs(testGain[test + 1] - (gain[i] + 2.0 * gain[i + 1]) / 3.0)));
+			const bool refine(error > tolerance);
+			for (unsigned int j = 0; j < 2; ++j, ++test)
+			{
+				newFrequency.push_back(testFrequency[test]);
+				newGain.push_back(testGain[test]);
+				newActive.push_back(refine);
+			}
+			newActive.push_back(refine);
+		}
+		newFrequency.push_back(frequency.back());
+		newGain.push_back(gain.back());
+
+		frequency.swap(newFrequency);
+		gain.swap(newGain);
+		active.swap(newActive);
+		tested.resize(active.size());
+	}
+}
+
+void ParabolaCalculator::ComputeResponse(const double* frequency, double* gain, const unsigned int& count) const
 {
 	// Current implementation of the response calculation is based on the equations given here:
 	// http://www.dzwiekinatury.pl/upload/files/strony/4/the_parabolic_reflector_sten_wahlstr%C3%B6m.pdf
@@ -59,69 +193,154 @@ ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetResponse(const unsign
 	// - l          = parabola depth
 	// - l / a      = depth-to-focus ratio
 	// - a / lambda = focus-to-wavelength ratio
-	
+
 	// Other sources that were tried and rejcted:
 	// https://www.wildtronics.com/parabolicaccuracy.html#.YBQSbPtKg5k
 	// https://www.electronics-notes.com/articles/antennas-propagation/parabolic-reflector-antenna/antenna-gain-directivity.php
-	
-	Vector2DVectors response(pointCount);
-	const double minFrequency(100.0);// [Hz] something small enough to show the low-frequency response without making the x-axis scaling unnecessarily tight
-	const double frequencyStep((maxFrequency - minFrequency) / (pointCount - 1));
-	const double depthToFocusRatio(GetParabolaDepth() / parabolaInfo.focusPosition);// [-]
-	for (unsigned int i = 0; i < pointCount; ++i)
-	{
-		response[i](0) = minFrequency + i * frequencyStep;
-		const double wavelength(speedOfSound / response[i](0));// [in]
-		const double focusToWavelengthRatio(parabolaInfo.focusPosition / wavelength);// [-]
-		const double b(log(1.0 + depthToFocusRatio));// [-] helper variable to clean up the below expression
-		const double pressureFactor(sqrt(1.0 + pow(4.0 * M_PI * focusToWavelengthRatio * b, 2) + 8.0 * M_PI * focusToWavelengthRatio * b * sin(4.0 * M_PI * focusToWavelengthRatio)));// [-]
-		response[i](1) = 20.0 * log10(pressureFactor);
-	}
 
-	return response;
+	// Pressure factor is sqrt(1 + (4 * pi * a / lambda * b)^2 + 8 * pi * a / lambda * b * sin(4 * pi * a / lambda)).
+	// The kernel works in terms of k = 4 * pi * a / lambda = 4 * pi * a * f / c, so everything that does not
+	// depend on frequency is computed once here.
+	const double depthToFocusRatio(GetParabolaDepth() / parabolaInfo.focusPosition);// [-]
+	const double b(log(1.0 + depthToFocusRatio));// [-] helper variable to clean up the above expression
+	const double wavenumberScale(4.0 * M_PI * parabolaInfo.focusPosition / speedOfSound);// [sec]
+	ResponseKernel::ComputeGain(frequency, gain, count, wavenumberScale, b);
 }
 
+// Vector2DVectors storage is contiguous (x0, y0, x1, y1, ...), so these write straight into it with a stride of two
+static_assert(sizeof(Eigen::Vector2d) == 2 * sizeof(double), "Vector2DVectors must be tightly packed");
+
 ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetParabolaShape(const unsigned int& pointCount) const
 {
 	Vector2DVectors shape(pointCount);
+	GetParabolaShape(pointCount, shape.front().data(), shape.front().data() + 1, 2);
+	return shape;
+}
+
+void ParabolaCalculator::GetParabolaShape(const unsigned int& pointCount, double* x, double* y, const unsigned int& stride) const
+{
 	const double xStep(parabolaInfo.diameter * 0.5 / (pointCount - 1));
-	shape.front() = Eigen::Vector2d::Zero();
-	for (unsigned int i = 1; i < pointCount; ++i)
+	for (unsigned int i = 0; i < pointCount; ++i)
 	{
-		shape[i](0) = shape[i - 1](0) + xStep;
-		shape[i](1) = shape[i](0) * shape[i](0) * 0.25 / parabolaInfo.focusPosition;
+		const double r(i * xStep);
+		x[i * stride] = r;
+		y[i * stride] = r * r * 0.25 / parabolaInfo.focusPosition;
 	}
+}
 
+ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetFacetShape(const unsigned int& pointCount) const
+{
+	Vector2DVectors shape(pointCount);
+	GetFacetShape(pointCount, shape.front().data(), shape.front().data() + 1, 2);
 	return shape;
 }
 
-ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetFacetShape(const unsigned int& pointCount) const
+void ParabolaCalculator::GetFacetShape(const unsigned int& pointCount, double* x, double* y, const unsigned int& stride) const
 {
 	assert(pointCount % 2 == 0 && "Requires even number of points");
 
 	const unsigned int halfPointCount(static_cast<unsigned int>(0.5 * pointCount));
 	const double xStep(0.5 * parabolaInfo.diameter / (halfPointCount - 1));
 	
-	Vector2DVectors shape(pointCount);
 	for (unsigned int i = 0; i < halfPointCount; ++i)
 	{
 		const double radius(i * xStep);
-		shape[i](0) = ComputeParabolaArcLength(radius);
-		shape[i](1) = M_PI * radius / parabolaInfo.facetCount;// Divide circumference at this radius by the number of facets, then take half of that value
+		const unsigned int mirror(pointCount - 1 - i);
+		x[i * stride] = ComputeParabolaArcLength(radius);
+		y[i * stride] = ComputeFacetHalfWidth(radius);
 		
 		// Symmetric about the x-axis
-		shape[pointCount - 1 - i](0) = shape[i](0);
-		shape[pointCount - 1 - i](1) = -shape[i](1);
+		x[mirror * stride] = x[i * stride];
+		y[mirror * stride] = -y[i * stride];
 	}
+}
 
+ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetFacetShape(const ReflectorProfile& profile, const unsigned int& pointCount) const
+{
+	Vector2DVectors shape(pointCount);
+	GetFacetShape(profile, pointCount, shape.front().data(), shape.front().data() + 1, 2);
 	return shape;
 }
 
-double ParabolaCalculator::ComputeParabolaArcLength(const double& radius) const
+void ParabolaCalculator::GetFacetShape(const ReflectorProfile& profile, const unsigned int& pointCount, double* x, double* y, const unsigned int& stride) const
 {
-	// Computed by:
-	// integral of sqrt(1 + d/dx(parabola equation)) dx from 0 to radius
-	const double w(0.5 * radius / parabolaInfo.focusPosition);
-	const double s(sqrt(1 + w * w));
-	return parabolaInfo.focusPosition * (w * s + log(w + s));
+	assert(pointCount % 2 == 0 && "Requires even number of points");
+
+	const unsigned int halfPointCount(static_cast<unsigned int>(0.5 * pointCount));
+	const double xStep(profile.GetRimRadius() / (halfPointCount - 1));
+
+	for (unsigned int i = 0; i < halfPointCount; ++i)
+	{
+		const double radius(i * xStep);
+		const unsigned int mirror(pointCount - 1 - i);
+		x[i * stride] = profile.GetArcLength(radius);
+		y[i * stride] = ComputeFacetHalfWidth(radius);
+
+		x[mirror * stride] = x[i * stride];
+		y[mirror * stride] = -y[i * stride];
+	}
+}
+
+ParabolaCalculator::Vector2DVectors ParabolaCalculator::GetAdaptiveFacetShape(const double& maxDeviation, double& achievedDeviation) const
+{
+	// The outline is P(r) = (s(r), w(r)) with arc length s and half-width w linear in radius.  Since the outline is
+	// convex, the largest deviation between a segment and its chord occurs where the tangent is parallel to the chord.
+	// With w' constant, that's where s'(r) = sqrt(1 + (r / 2a)^2) equals the chord's ds/dr, which we can solve directly.
+	const double a(parabolaInfo.focusPosition);
+	auto point([this](const double& r)
+	{
+		return Eigen::Vector2d(ComputeParabolaArcLength(r), ComputeFacetHalfWidth(r));
+	});
+
+	auto chordDeviation([&a, &point](const double& r0, const double& r1, const Eigen::Vector2d& p0, const Eigen::Vector2d& p1)
+	{
+		const Eigen::Vector2d chord(p1 - p0);
+		const double slope(chord(0) / (r1 - r0));
+		const double rStar(std::min(std::max(2.0 * a * sqrt(std::max(slope * slope - 1.0, 0.0)), r0), r1));
+		const Eigen::Vector2d offset(point(rStar) - p0);
+		return fabs(chord(0) * offset(1) - chord(1) * offset(0)) / chord.norm();
+	});
+
+	// Depth-first subdivision, so accepted segments come off the stack in order of increasing radius
+	struct Segment
+	{
+		double r0, r1;
+	};
+
+	const double rimRadius(0.5 * parabolaInfo.diameter);
+	std::vector<double> radii(1, 0.0);
+	std::vector<Segment> stack(1, Segment{ 0.0, rimRadius });
+	achievedDeviation = 0.0;
+	const unsigned int maxPointCount(1000000);// Guard against unreachable tolerances
+	while (!stack.empty())
+	{
+		const Segment segment(stack.back());
+		stack.pop_back();
+
+		const double deviation(chordDeviation(segment.r0, segment.r1, point(segment.r0), point(segment.r1)));
+		if (deviation > maxDeviation && radii.size() + stack.size() < maxPointCount)
+		{
+			const double rMid(0.5 * (segment.r0 + segment.r1));
+			stack.push_back(Segment{ rMid, segment.r1 });
+			stack.push_back(Segment{ segment.r0, rMid });
+			continue;
+		}
+
+		achievedDeviation = std::max(achievedDeviation, deviation);
+		radii.push_back(segment.r1);
+	}
+
+	const unsigned int halfPointCount(static_cast<unsigned int>(radii.size()));
+	const unsigned int pointCount(2 * halfPointCount);
+	Vector2DVectors shape(pointCount);
+	for (unsigned int i = 0; i < halfPointCount; ++i)
+	{
+		shape[i] = point(radii[i]);
+
+		// Symmetric about the x-axis
+		shape[pointCount - 1 - i](0) = shape[i](0);
+		shape[pointCount - 1 - i](1) = -shape[i](1);
+	}
+
+	return shape;
 }
@@ -15,12 +15,17 @@
 #ifndef PARABOLA_CALCULATOR_H_
 #define PARABOLA_CALCULATOR_H_
 
+// Local headers
+#include "constexprMath.h"
+
 // Eigen headers
 #include <Eigen/Eigen>
 
 // Standard C++ headers
 #include <vector>
 
+class ReflectorProfile;
+
 class ParabolaCalculator
 {
 public:
@@ -31,23 +36,99 @@ public:
 		unsigned int facetCount = 10;
 	};
 	
-	void SetParabolaInfo(const ParabolaInfo& info) { parabolaInfo = info; }
+	constexpr ParabolaCalculator() = default;
+	constexpr explicit ParabolaCalculator(const ParabolaInfo& info) : parabolaInfo(info) {}
 
-	double GetParabolaDepth() const;
-	double GetMaxDesignError() const;
+	// Calculations are all const, so a calculator constructed for a specific design may be shared between threads
+	constexpr void SetParabolaInfo(const ParabolaInfo& info) { parabolaInfo = info; }
+	constexpr const ParabolaInfo& GetParabolaInfo() const { return parabolaInfo; }
+
+	// The scalar calculations are constexpr so designs known at compile time can be baked into static tables
+	constexpr double GetParabolaDepth() const;
+	constexpr double GetMaxDesignError() const;
+	constexpr double ComputeParabolaArcLength(const double& radius) const;
+	constexpr double ComputeFacetHalfWidth(const double& radius) const;
 	
+	static const double speedOfSound;// [in/sec]
+
 	typedef std::vector<Eigen::Vector2d, Eigen::aligned_allocator<Eigen::Vector2d>> Vector2DVectors;
 	
-	Vector2DVectors GetResponse(const unsigned int& pointCount, const double& maxFrequency) const;
+	enum class FrequencySpacing
+	{
+		Linear,
+		Logarithmic
+	};
+
+	Vector2DVectors GetResponse(const unsigned int& pointCount, const double& maxFrequency, const FrequencySpacing& spacing = FrequencySpacing::Linear) const;
+	static std::vector<double> GetResponseFrequencies(const unsigned int& pointCount, const double& maxFrequency, const FrequencySpacing& spacing = FrequencySpacing::Linear);
+	static void GetResponseFrequencies(const unsigned int& pointCount, const double& maxFrequency, const FrequencySpacing& spacing, double* frequency);
+
+	// Starts from a log-spaced grid fine enough to capture every ripple in the response, then subdivides (in log-frequency)
+	// any interval where the gain at its interior test points differs from the straight line between its ends by more than
+	// tolerance [dB].  Refinement never takes the result past maxPointCount (only the initial grid, which resolves the
+	// ripple, can be larger than that).
+	Vector2DVectors GetAdaptiveResponse(const double& maxFrequency, const double& tolerance, const unsigned int& maxPointCount = 2000) const;
+	void GetAdaptiveResponse(const double& maxFrequency, const double& tolerance, std::vector<double>& frequency, std::vector<double>& gain, const unsigned int& maxPointCount = 2000) const;
+
+	// Evaluates the gain [dB] at each of the specified frequencies [Hz] (vectorized where supported)
+	void ComputeResponse(const double* frequency, double* gain, const unsigned int& count) const;
+
 	Vector2DVectors GetParabolaShape(const unsigned int& pointCount) const;
 	Vector2DVectors GetFacetShape(const unsigned int& pointCount) const;
 
+	// Places points along the facet outline according to its curvature, so that no chord deviates from the true
+	// outline by more than maxDeviation [in].  The largest deviation actually achieved [in] is also returned.
+	// Output has the same form as GetFacetShape (apex to rim, then back along the mirror image).
+	Vector2DVectors GetAdaptiveFacetShape(const double& maxDeviation, double& achievedDeviation) const;
+
+	// Facet outline for an arbitrary axisymmetric profile (divided into this design's facet count), in the same form as
+	// GetFacetShape.  Arc lengths come from the profile's cached table, so repeated calls for one profile are cheap.
+	Vector2DVectors GetFacetShape(const ReflectorProfile& profile, const unsigned int& pointCount) const;
+
+	// These versions write directly to caller-provided arrays, each with room for pointCount values.  The stride
+	// (in doubles) between consecutive values allows writing into interleaved storage.
+	void GetResponse(const unsigned int& pointCount, const double& maxFrequency, const FrequencySpacing& spacing, double* frequency, double* gain) const;
+	void GetParabolaShape(const unsigned int& pointCount, double* x, double* y, const unsigned int& stride = 1) const;
+	void GetFacetShape(const unsigned int& pointCount, double* x, double* y, const unsigned int& stride = 1) const;
+	void GetFacetShape(const ReflectorProfile& profile, const unsigned int& pointCount, double* x, double* y, const unsigned int& stride = 1) const;
+
 private:
-	static const double speedOfSound;// [in/sec]
+	static const double minResponseFrequency;// [Hz]
 	
 	ParabolaInfo parabolaInfo;
 	
-	double ComputeParabolaArcLength(const double& radius) const;
+	static Vector2DVectors Interleave(const std::vector<double>& x, const std::vector<double>& y);
 };
 
+constexpr double ParabolaCalculator::GetParabolaDepth() const
+{
+	return parabolaInfo.diameter * parabolaInfo.diameter * 0.0625 / parabolaInfo.focusPosition;
+}
+
+constexpr double ParabolaCalculator::GetMaxDesignError() const
+{
+	// The design creates the desired parabola along the center of each facet.  So the
+	// largest error will be at the widest part of the parabola, were two facets join.
+	// We'll report the error in a plane perpendicular to the axis of the parabola.
+	
+	const double halfFacetWidth(ComputeFacetHalfWidth(0.5 * parabolaInfo.diameter));
+	const double jointDistance(ConstexprMath::Sqrt(parabolaInfo.diameter * parabolaInfo.diameter * 0.25 + halfFacetWidth * halfFacetWidth));
+
+	return jointDistance - 0.5 * parabolaInfo.diameter;
+}
+
+constexpr double ParabolaCalculator::ComputeParabolaArcLength(const double& radius) const
+{
+	// Computed by:
+	// integral of sqrt(1 + d/dx(parabola equation)) dx from 0 to radius
+	const double w(0.5 * radius / parabolaInfo.focusPosition);
+	const double s(ConstexprMath::Sqrt(1 + w * w));
+	return parabolaInfo.focusPosition * (w * s + ConstexprMath::Log(w + s));
+}
+
+constexpr double ParabolaCalculator::ComputeFacetHalfWidth(const double& radius) const
+{
+	return M_PI * radius / parabolaInfo.facetCount;// Divide circumference at this radius by the number of facets, then take half of that value
+}
+
 #endif// PARABOLA_CALCULATOR_H_
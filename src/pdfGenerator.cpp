@@ -0,0 +1,189 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  pdfGenerator.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Writes flat patterns directly to a multi-page PDF file.
+
+// Local headers
+#include "pdfGenerator.h"
+
+// Standard C++ headers
+#include <cmath>
+#include <cstdio>
+
+void PDFGenerator::WriteHeader(std::ostream& out)
+{
+	objectOffsets.assign(3, 0);
+	pageObjects.clear();
+
+	// Binary characters in the comment tell file transfer tools not to treat this as text
+	out << "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n";
+}
+
+unsigned int PDFGenerator::BeginObject(std::ostream& out)
+{
+	objectOffsets.push_back(0);
+	BeginObject(objectOffsets.size() - 1, out);
+	return objectOffsets.size() - 1;
+}
+
+void PDFGenerator::BeginObject(const unsigned int& object, std::ostream& out)
+{
+	objectOffsets[object] = out.tellp();
+	OutputBuffer buffer;
+	buffer << object << " 0 obj\n";
+	out << buffer;
+}
+
+// Page content is drawn in [mm] (the first operator scales from points), with TikZ's default line widths
+void PDFGenerator::WritePageContent(const Page& page, OutputBuffer& out) const
+{
+	out << "2.834646 0 0 2.834646 0 0 cm\n"
+		<< "0.1411 w\n"
+		<< "1 J 1 j\n";
+
+	if (page.includeScale)
+		WriteScale(out);
+
+	for (const auto& path : page.paths)
+	{
+		WritePath(path, Eigen::Vector2d::Zero(), out);
+		out << "S\n";
+	}
+
+	if (page.offsets.size() > 1)
+	{
+		for (const auto& mark : GetAlignmentMarks())
+			WriteAlignmentMark(mark, out);
+		WritePageMatrix(page.offsets, page.offsets[page.index], out);
+	}
+}
+
+void PDFGenerator::WritePage(const std::string& content, std::ostream& out)
+{
+	OutputBuffer buffer(precision);
+	const unsigned int contentObject(BeginObject(out));
+	buffer << "<< /Length " << content.size() << " >>\nstream\n";
+	out << buffer << content << "\nendstream\nendobj\n";
+
+	pageObjects.push_back(BeginObject(out));
+	buffer.Clear();
+	buffer << "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 " << pageWidth * 72.0 << ' ' << pageHeight * 72.0
+		<< "] /Contents " << contentObject << " 0 R /Resources << >> >>\nendobj\n";
+	out << buffer;
+}
+
+void PDFGenerator::WriteFooter(std::ostream& out)
+{
+	OutputBuffer buffer;
+	BeginObject(2, out);
+	buffer << "<< /Type /Pages /Kids [";
+	for (const auto& p : pageObjects)
+		buffer << ' ' << p << " 0 R";
+	buffer << " ] /Count " << pageObjects.size() << " >>\nendobj\n";
+	out << buffer;
+
+	BeginObject(1, out);
+	out << "<< /Type /Catalog /Pages 2 0 R >>\nendobj\n";
+
+	// Each cross-reference entry must be exactly 20 bytes
+	const std::streamoff xrefOffset(out.tellp());
+	buffer.Clear();
+	buffer << "xref\n0 " << objectOffsets.size() << "\n0000000000 65535 f \n";
+	for (unsigned int i = 1; i < objectOffsets.size(); ++i)
+	{
+		char entry[21];
+		std::snprintf(entry, sizeof(entry), "%010lld 00000 n \n", static_cast<long long>(objectOffsets[i]));
+		buffer << entry;
+	}
+
+	buffer << "trailer\n<< /Size " << objectOffsets.size() << " /Root 1 0 R >>\n"
+		<< "startxref\n" << static_cast<long long>(xrefOffset) << "\n%%EOF\n";
+	out << buffer;
+}
+
+void PDFGenerator::WritePath(const Vector2DVectors& path, const Eigen::Vector2d& origin, OutputBuffer& out)
+{
+	out << path.front()(0) + origin(0) << ' ' << path.front()(1) + origin(1) << " m\n";
+	for (unsigned int i = 1; i < path.size(); ++i)
+		out << path[i](0) + origin(0) << ' ' << path[i](1) + origin(1) << " l\n";
+}
+
+// Cubic Bezier approximation of a quarter circle, continuing the current path from the arc's start point
+void PDFGenerator::WriteQuarterArc(const Eigen::Vector2d& center, const double& radius, const double& startAngle, const double& endAngle, OutputBuffer& out)
+{
+	const double controlLength(0.5522847498 * radius * (endAngle > startAngle ? 1.0 : -1.0));
+	const double start(startAngle * M_PI / 180.0);
+	const double end(endAngle * M_PI / 180.0);
+
+	const Eigen::Vector2d startPoint(center + radius * Eigen::Vector2d(cos(start), sin(start)));
+	const Eigen::Vector2d endPoint(center + radius * Eigen::Vector2d(cos(end), sin(end)));
+	const Eigen::Vector2d control1(startPoint + controlLength * Eigen::Vector2d(-sin(start), cos(start)));
+	const Eigen::Vector2d control2(endPoint - controlLength * Eigen::Vector2d(-sin(end), cos(end)));
+
+	out << control1(0) << ' ' << control1(1) << ' ' << control2(0) << ' ' << control2(1) << ' ' << endPoint(0) << ' ' << endPoint(1) << " c\n";
+}
+
+void PDFGenerator::WriteScale(OutputBuffer& out) const
+{
+	const auto origin(GetScaleOrigin());
+	WritePath(scaleMark, Eigen::Vector2d(origin.x * 25.4, origin.y * 25.4), out);
+	out << "S\n";
+}
+
+void PDFGenerator::WriteAlignmentMark(const AlignmentMark& mark, OutputBuffer& out) const
+{
+	const Eigen::Vector2d center(mark.center.x * 25.4, mark.center.y * 25.4);
+	const double& r(mark.radius);
+
+	// Two opposite quadrants filled
+	out << center(0) << ' ' << center(1) << " m\n";
+	if (mark.rotation == MarkRotation::Normal)
+	{
+		out << center(0) + r << ' ' << center(1) << " l\n";
+		WriteQuarterArc(center, r, 0.0, 90.0, out);
+		out << center(0) << ' ' << center(1) - r << " l\n";
+		WriteQuarterArc(center, r, 270.0, 180.0, out);
+	}
+	else
+	{
+		out << center(0) << ' ' << center(1) + r << " l\n";
+		WriteQuarterArc(center, r, 90.0, 180.0, out);
+		out << center(0) + r << ' ' << center(1) << " l\n";
+		WriteQuarterArc(center, r, 0.0, -90.0, out);
+	}
+	out << "h f\n";
+
+	out << center(0) + r << ' ' << center(1) << " m\n";
+	for (unsigned int i = 0; i < 4; ++i)
+		WriteQuarterArc(center, r, 90.0 * i, 90.0 * (i + 1), out);
+	out << "h S\n";
+}
+
+void PDFGenerator::WritePageMatrix(const std::vector<PageOffset>& offsets, const PageOffset& currentOffset, OutputBuffer& out) const
+{
+	const auto matrix(GetPageMatrix(offsets, currentOffset));
+	const Eigen::Vector2d origin(matrix.origin.x * 25.4, matrix.origin.y * 25.4);
+
+	out << "q\n0.0353 w\n";// Very thin
+	const double tolerance(1.0e-6);// [-]
+	const auto columns(static_cast<unsigned int>(matrix.width / matrix.cellWidth + tolerance));
+	const auto rows(static_cast<unsigned int>(matrix.height / matrix.cellHeight + tolerance));
+	for (unsigned int i = 0; i <= columns; ++i)
+		out << origin(0) + i * matrix.cellWidth << ' ' << origin(1) << " m " << origin(0) + i * matrix.cellWidth << ' ' << origin(1) + matrix.height << " l\n";
+	for (unsigned int i = 0; i <= rows; ++i)
+		out << origin(0) << ' ' << origin(1) + i * matrix.cellHeight << " m " << origin(0) + matrix.width << ' ' << origin(1) + i * matrix.cellHeight << " l\n";
+	out << "S\nQ\n";
+
+	const Eigen::Vector2d cellSize(matrix.currentUpperRight - matrix.currentLowerLeft);
+	out << origin(0) + matrix.currentLowerLeft(0) << ' ' << origin(1) + matrix.currentLowerLeft(1) << ' '
+		<< cellSize(0) << ' ' << cellSize(1) << " re f\n";
+}
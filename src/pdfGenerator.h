@@ -0,0 +1,50 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  pdfGenerator.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Writes flat patterns directly to a multi-page PDF file.
+
+#ifndef PDF_GENERATOR_H_
+#define PDF_GENERATOR_H_
+
+// Local headers
+#include "flatPatternGenerator.h"
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <ios>
+
+class PDFGenerator : public FlatPatternGenerator
+{
+protected:
+	void WriteHeader(std::ostream& out) override;
+	void WritePageContent(const Page& page, OutputBuffer& out) const override;
+	void WritePage(const std::string& content, std::ostream& out) override;
+	void WriteFooter(std::ostream& out) override;
+
+private:
+	// Object 1 is the catalog and object 2 is the page tree; both are written last, once all pages are known
+	std::vector<std::streamoff> objectOffsets;// Index is the object number
+	std::vector<unsigned int> pageObjects;
+
+	unsigned int BeginObject(std::ostream& out);
+	void BeginObject(const unsigned int& object, std::ostream& out);
+
+	// Content stream helpers; coordinates are [mm]
+	static void WritePath(const Vector2DVectors& path, const Eigen::Vector2d& origin, OutputBuffer& out);
+	static void WriteQuarterArc(const Eigen::Vector2d& center, const double& radius, const double& startAngle, const double& endAngle, OutputBuffer& out);// [deg]
+	void WriteScale(OutputBuffer& out) const;
+	void WriteAlignmentMark(const AlignmentMark& mark, OutputBuffer& out) const;
+	void WritePageMatrix(const std::vector<PageOffset>& offsets, const PageOffset& currentOffset, OutputBuffer& out) const;
+};
+
+#endif// PDF_GENERATOR_H_
@@ -0,0 +1,174 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  reflectorProfile.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  General axisymmetric reflector profiles (analytic or tabulated).
+
+// Local headers
+#include "reflectorProfile.h"
+#include "gaussLegendre.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+double ReflectorProfile::GetArcLength(const double& radius) const
+{
+	std::call_once(tableFlag, &ReflectorProfile::BuildArcLengthTable, this);
+
+	const double position(std::min(std::max(radius, 0.0), rimRadius) / table->radiusStep);
+	const auto panel(std::min(static_cast<unsigned int>(position), static_cast<unsigned int>(table->arcLength.size()) - 2));
+	const double t(position - panel);
+	const double t2(t * t);
+	const double t3(t2 * t);
+
+	return (2.0 * t3 - 3.0 * t2 + 1.0) * table->arcLength[panel]
+		+ (t3 - 2.0 * t2 + t) * table->radiusStep * table->derivative[panel]
+		+ (-2.0 * t3 + 3.0 * t2) * table->arcLength[panel + 1]
+		+ (t3 - t2) * table->radiusStep * table->derivative[panel + 1];
+}
+
+void ReflectorProfile::BuildArcLengthTable() const
+{
+	const unsigned int panelCount(256);
+	const unsigned int order(8);
+
+	table = std::make_unique<ArcLengthTable>();
+	table->radiusStep = rimRadius / panelCount;
+	table->arcLength.resize(panelCount + 1);
+	table->derivative.resize(panelCount + 1);
+
+	auto arcLengthDerivative([this](const double& r)
+	{
+		const double slope(GetSlope(r));
+		return sqrt(1.0 + slope * slope);
+	});
+
+	// Same rule on every panel, shifted by the panel start
+	const auto rule(GaussLegendre::GetRule(order, 0.0, table->radiusStep));
+
+	table->arcLength.front() = 0.0;
+	table->derivative.front() = arcLengthDerivative(0.0);
+	for (unsigned int i = 0; i < panelCount; ++i)
+	{
+		const double start(i * table->radiusStep);
+		double panelLength(0.0);
+		for (unsigned int j = 0; j < order; ++j)
+			panelLength += rule.weight[j] * arcLengthDerivative(start + rule.node[j]);
+
+		table->arcLength[i + 1] = table->arcLength[i] + panelLength;
+		table->derivative[i + 1] = arcLengthDerivative(start + table->radiusStep);
+	}
+}
+
+ConicProfile::ConicProfile(const double& rimRadius, const double& vertexRadius, const double& _conicConstant)
+	: ReflectorProfile(rimRadius), curvature(1.0 / vertexRadius), conicConstant(_conicConstant)
+{
+	assert((1.0 + conicConstant) * curvature * curvature * rimRadius * rimRadius < 1.0 && "Rim is beyond the extent of the conic");
+}
+
+std::unique_ptr<ConicProfile> ConicProfile::CreateParaboloid(const double& rimRadius, const double& focusPosition)
+{
+	return std::make_unique<ConicProfile>(rimRadius, 2.0 * focusPosition, -1.0);
+}
+
+std::unique_ptr<ConicProfile> ConicProfile::CreateEllipsoid(const double& rimRadius, const double& nearFocus, const double& farFocus)
+{
+	assert(farFocus > nearFocus);
+	const double eccentricity((farFocus - nearFocus) / (farFocus + nearFocus));
+	const double vertexRadius(2.0 * nearFocus * farFocus / (nearFocus + farFocus));
+	return std::make_unique<ConicProfile>(rimRadius, vertexRadius, -eccentricity * eccentricity);
+}
+
+double ConicProfile::GetHeight(const double& radius) const
+{
+	const double r2(radius * radius);
+	return curvature * r2 / (1.0 + sqrt(1.0 - (1.0 + conicConstant) * curvature * curvature * r2));
+}
+
+double ConicProfile::GetSlope(const double& radius) const
+{
+	return curvature * radius / sqrt(1.0 - (1.0 + conicConstant) * curvature * curvature * radius * radius);
+}
+
+TabulatedProfile::TabulatedProfile(const std::vector<double>& _radius, const std::vector<double>& _height)
+	: ReflectorProfile(_radius.back()), radius(_radius), height(_height)
+{
+	assert(radius.size() == height.size() && radius.size() > 1);
+	assert(radius.front() == 0.0);
+
+	// Spline moments from the tridiagonal system, with zero slope at the apex and constant curvature over the last
+	// interval (so profiles that are locally quadratic near the rim are reproduced exactly)
+	const unsigned int n(static_cast<unsigned int>(radius.size()));
+	std::vector<double> diagonal(n), upper(n), rhs(n);
+	for (unsigned int i = 0; i < n - 1; ++i)
+	{
+		const double h(radius[i + 1] - radius[i]);
+		assert(h > 0.0);
+		const double slope((height[i + 1] - height[i]) / h);
+		upper[i] = h;
+		if (i == 0)
+		{
+			diagonal[0] = 2.0 * h;
+			rhs[0] = 6.0 * slope;
+		}
+		else
+		{
+			const double hPrevious(radius[i] - radius[i - 1]);
+			diagonal[i] = 2.0 * (hPrevious + h);
+			rhs[i] = 6.0 * (slope - (height[i] - height[i - 1]) / hPrevious);
+
+			// Forward elimination
+			const double factor(hPrevious / diagonal[i - 1]);
+			diagonal[i] -= factor * upper[i - 1];
+			rhs[i] -= factor * rhs[i - 1];
+		}
+	}
+
+	// Last row is M[n - 1] - M[n - 2] = 0
+	diagonal[n - 1] = 1.0 + upper[n - 2] / diagonal[n - 2];
+	rhs[n - 1] = rhs[n - 2] / diagonal[n - 2];
+
+	secondDerivative.resize(n);
+	secondDerivative[n - 1] = rhs[n - 1] / diagonal[n - 1];
+	for (int i = static_cast<int>(n) - 2; i >= 0; --i)
+		secondDerivative[i] = (rhs[i] - upper[i] * secondDerivative[i + 1]) / diagonal[i];
+}
+
+unsigned int TabulatedProfile::FindInterval(const double& r) const
+{
+	const auto it(std::upper_bound(radius.begin(), radius.end(), r));
+	const auto i(static_cast<unsigned int>(std::max(it - radius.begin(), static_cast<std::ptrdiff_t>(1)) - 1));
+	return std::min(i, static_cast<unsigned int>(radius.size()) - 2);
+}
+
+double TabulatedProfile::GetHeight(const double& r) const
+{
+	const unsigned int i(FindInterval(r));
+	const double h(radius[i + 1] - radius[i]);
+	const double a(radius[i + 1] - r);
+	const double b(r - radius[i]);
+	return (secondDerivative[i] * a * a * a + secondDerivative[i + 1] * b * b * b) / (6.0 * h)
+		+ (height[i] / h - secondDerivative[i] * h / 6.0) * a
+		+ (height[i + 1] / h - secondDerivative[i + 1] * h / 6.0) * b;
+}
+
+double TabulatedProfile::GetSlope(const double& r) const
+{
+	const unsigned int i(FindInterval(r));
+	const double h(radius[i + 1] - radius[i]);
+	const double a(radius[i + 1] - r);
+	const double b(r - radius[i]);
+	return (secondDerivative[i + 1] * b * b - secondDerivative[i] * a * a) / (2.0 * h)
+		+ (height[i + 1] - height[i]) / h
+		- (secondDerivative[i + 1] - secondDerivative[i]) * h / 6.0;
+}
@@ -0,0 +1,98 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  reflectorProfile.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  General axisymmetric reflector profiles (analytic or tabulated).
+
+#ifndef REFLECTOR_PROFILE_H_
+#define REFLECTOR_PROFILE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <mutex>
+
+// Profile z(r) of a reflector that is symmetric about its axis, with the apex at r = 0, z = 0
+class ReflectorProfile
+{
+public:
+	explicit ReflectorProfile(const double& _rimRadius) : rimRadius(_rimRadius) {}
+	virtual ~ReflectorProfile() = default;
+
+	ReflectorProfile(const ReflectorProfile&) = delete;
+	ReflectorProfile& operator=(const ReflectorProfile&) = delete;
+
+	double GetRimRadius() const { return rimRadius; }// [in]
+
+	virtual double GetHeight(const double& radius) const = 0;// [in]
+	virtual double GetSlope(const double& radius) const = 0;// dz/dr [-]
+
+	// Arc length [in] along the profile from the apex.  Uses a table built once (on first use)
+	// and shared by all subsequent queries.  Safe to call from multiple threads.
+	double GetArcLength(const double& radius) const;
+
+private:
+	const double rimRadius;// [in]
+
+	// Cumulative arc length at evenly spaced radii, from composite Gauss-Legendre quadrature.
+	// Queries use cubic Hermite interpolation with the exact derivative ds/dr = sqrt(1 + z'^2) at each knot.
+	struct ArcLengthTable
+	{
+		double radiusStep;
+		std::vector<double> arcLength;
+		std::vector<double> derivative;
+	};
+
+	mutable std::once_flag tableFlag;
+	mutable std::unique_ptr<ArcLengthTable> table;
+
+	void BuildArcLengthTable() const;
+};
+
+// Conic section of revolution:  z = c * r^2 / (1 + sqrt(1 - (1 + K) * c^2 * r^2)), with c = 1 / (vertex radius of curvature).
+// K = -1 is a paraboloid, -1 < K < 0 a prolate ellipsoid, K = 0 a sphere and K < -1 a hyperboloid.
+// Conics other than the paraboloid can be used to deliberately spread (defocus) the focal spot.
+class ConicProfile : public ReflectorProfile
+{
+public:
+	ConicProfile(const double& rimRadius, const double& vertexRadius, const double& conicConstant);
+
+	static std::unique_ptr<ConicProfile> CreateParaboloid(const double& rimRadius, const double& focusPosition);
+	// Ellipsoid with apex-to-focus distances nearFocus (where the microphone goes) and farFocus
+	static std::unique_ptr<ConicProfile> CreateEllipsoid(const double& rimRadius, const double& nearFocus, const double& farFocus);
+
+	double GetHeight(const double& radius) const override;
+	double GetSlope(const double& radius) const override;
+
+private:
+	const double curvature;// [1/in]
+	const double conicConstant;// [-]
+};
+
+// Profile through measured or otherwise tabulated (r, z) points.  Interpolated with a cubic spline
+// that has zero slope at the apex.  Radii must be strictly increasing and start at zero.
+class TabulatedProfile : public ReflectorProfile
+{
+public:
+	TabulatedProfile(const std::vector<double>& radius, const std::vector<double>& height);
+
+	double GetHeight(const double& radius) const override;
+	double GetSlope(const double& radius) const override;
+
+private:
+	const std::vector<double> radius;
+	const std::vector<double> height;
+	std::vector<double> secondDerivative;
+
+	unsigned int FindInterval(const double& r) const;
+};
+
+#endif// REFLECTOR_PROFILE_H_
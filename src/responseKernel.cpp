@@ -0,0 +1,238 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  responseKernel.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Vectorized evaluation of the reflector gain equations.
+
+// Local headers
+#include "responseKernel.h"
+
+// Standard C++ headers
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RESPONSE_KERNEL_AVX2
+#include <immintrin.h>
+#endif
+
+namespace ResponseKernel
+{
+
+// The expression under the square root is rearranged to 1 + x * (x + 2 * sin(k)) with x = k * b,
+// and 20 * log10(sqrt(y)) becomes 10 * log10(y), so no pow() or sqrt() is required.
+void ComputeGainScalar(const double* frequency, double* gain, const std::size_t& count,
+	const double& wavenumberScale, const double& b)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const double k(wavenumberScale * frequency[i]);
+		const double x(k * b);
+		gain[i] = 10.0 * log10(1.0 + x * (x + 2.0 * sin(k)));
+	}
+}
+
+void SumPhasorsScalar(const double* pathDifference, const double* weight, const std::size_t& count,
+	const double& wavenumber, double& real, double& imaginary)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const double phase(wavenumber * pathDifference[i]);
+		real += weight[i] * cos(phase);
+		imaginary += weight[i] * sin(phase);
+	}
+}
+
+#ifdef RESPONSE_KERNEL_AVX2
+
+namespace
+{
+
+bool vectorizationEnabled(true);
+
+// sin(k).  Reduces to r = k - n * pi in [-pi/2, pi/2] (two-part Cody-Waite constant),
+// then evaluates the odd Taylor series through r^21, which is accurate to ~1e-16 over that interval.
+__attribute__((target("avx2,fma")))
+__m256d Sin(const __m256d& k)
+{
+	const __m256d n(_mm256_round_pd(_mm256_mul_pd(k, _mm256_set1_pd(M_1_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+	__m256d r(_mm256_fnmadd_pd(n, _mm256_set1_pd(3.141592653589793116), k));
+	r = _mm256_fnmadd_pd(n, _mm256_set1_pd(1.2246467991473532e-16), r);
+
+	const __m256d r2(_mm256_mul_pd(r, r));
+	__m256d p(_mm256_set1_pd(1.0 / 51090942171709440000.0));// 1/21!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(-1.0 / 121645100408832000.0));// 1/19!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(1.0 / 355687428096000.0));// 1/17!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(-1.0 / 1307674368000.0));// 1/15!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(1.0 / 6227020800.0));// 1/13!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(-1.0 / 39916800.0));// 1/11!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(1.0 / 362880.0));// 1/9!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(-1.0 / 5040.0));// 1/7!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(1.0 / 120.0));// 1/5!
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(-1.0 / 6.0));// 1/3!
+	p = _mm256_mul_pd(p, r2);
+	const __m256d s(_mm256_fmadd_pd(p, r, r));
+
+	// sin(r + n * pi) = (-1)^n * sin(r)
+	const __m256d halfN(_mm256_mul_pd(n, _mm256_set1_pd(0.5)));
+	const __m256d odd(_mm256_cmp_pd(_mm256_floor_pd(halfN), halfN, _CMP_NEQ_OQ));
+	return _mm256_xor_pd(s, _mm256_and_pd(odd, _mm256_set1_pd(-0.0)));
+}
+
+// log10(y) for y > 0 (returns -inf for zero and NaN for negative values, like log10()).
+// Splits y = m * 2^e with m in [sqrt(0.5), sqrt(2)), then log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1),
+// |s| < 0.172, using the series through s^23.
+__attribute__((target("avx2,fma")))
+__m256d Log10(const __m256d& y)
+{
+	const __m256i bits(_mm256_castpd_si256(y));
+	const __m256i biasedExponent(_mm256_srli_epi64(bits, 52));
+
+	// Convert the (small, non-negative) exponent bits to double by placing them in the mantissa of 2^52
+	const __m256d twoTo52(_mm256_set1_pd(4503599627370496.0));
+	__m256d e(_mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(biasedExponent, _mm256_castpd_si256(twoTo52))), twoTo52));
+	e = _mm256_sub_pd(e, _mm256_set1_pd(1023.0));
+
+	__m256d m(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+		_mm256_set1_epi64x(0x3FF0000000000000LL))));
+	const __m256d large(_mm256_cmp_pd(m, _mm256_set1_pd(M_SQRT2), _CMP_GT_OQ));
+	m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), large);
+	e = _mm256_add_pd(e, _mm256_and_pd(large, _mm256_set1_pd(1.0)));
+
+	const __m256d s(_mm256_div_pd(_mm256_sub_pd(m, _mm256_set1_pd(1.0)), _mm256_add_pd(m, _mm256_set1_pd(1.0))));
+	const __m256d s2(_mm256_mul_pd(s, s));
+	__m256d p(_mm256_set1_pd(1.0 / 23.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 21.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 19.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 17.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 15.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 13.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 11.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 9.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 7.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 5.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 3.0));
+	p = _mm256_mul_pd(p, s2);
+	const __m256d logM(_mm256_mul_pd(_mm256_set1_pd(2.0), _mm256_fmadd_pd(p, s, s)));
+
+	__m256d result(_mm256_mul_pd(_mm256_fmadd_pd(e, _mm256_set1_pd(M_LN2), logM), _mm256_set1_pd(M_LOG10E)));
+
+	// Special cases:  zero, negative and non-finite inputs
+	const __m256d zero(_mm256_setzero_pd());
+	result = _mm256_blendv_pd(result, _mm256_set1_pd(-HUGE_VAL), _mm256_cmp_pd(y, zero, _CMP_EQ_OQ));
+	result = _mm256_blendv_pd(result, _mm256_set1_pd(NAN), _mm256_cmp_pd(y, zero, _CMP_NGE_UQ));
+	result = _mm256_blendv_pd(result, y, _mm256_cmp_pd(y, _mm256_set1_pd(HUGE_VAL), _CMP_EQ_OQ));
+	return result;
+}
+
+__attribute__((target("avx2,fma")))
+std::size_t ComputeGainAVX2(const double* frequency, double* gain, const std::size_t& count,
+	const double& wavenumberScale, const double& b)
+{
+	const __m256d scale(_mm256_set1_pd(wavenumberScale));
+	const __m256d bVector(_mm256_set1_pd(b));
+	const __m256d one(_mm256_set1_pd(1.0));
+	const __m256d two(_mm256_set1_pd(2.0));
+	const __m256d ten(_mm256_set1_pd(10.0));
+
+	std::size_t i(0);
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m256d k(_mm256_mul_pd(scale, _mm256_loadu_pd(frequency + i)));
+		const __m256d x(_mm256_mul_pd(k, bVector));
+		const __m256d y(_mm256_fmadd_pd(x, _mm256_fmadd_pd(two, Sin(k), x), one));
+		_mm256_storeu_pd(gain + i, _mm256_mul_pd(ten, Log10(y)));
+	}
+
+	return i;
+}
+
+// cos(x) is evaluated as sin(x + pi / 2)
+__attribute__((target("avx2,fma")))
+std::size_t SumPhasorsAVX2(const double* pathDifference, const double* weight, const std::size_t& count,
+	const double& wavenumber, double& real, double& imaginary)
+{
+	const __m256d k(_mm256_set1_pd(wavenumber));
+	const __m256d quarterTurn(_mm256_set1_pd(M_PI_2));
+	__m256d realSum(_mm256_setzero_pd());
+	__m256d imaginarySum(_mm256_setzero_pd());
+
+	std::size_t i(0);
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m256d phase(_mm256_mul_pd(k, _mm256_loadu_pd(pathDifference + i)));
+		const __m256d w(_mm256_loadu_pd(weight + i));
+		realSum = _mm256_fmadd_pd(w, Sin(_mm256_add_pd(phase, quarterTurn)), realSum);
+		imaginarySum = _mm256_fmadd_pd(w, Sin(phase), imaginarySum);
+	}
+
+	alignas(32) double lanes[4];
+	_mm256_store_pd(lanes, realSum);
+	real += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	_mm256_store_pd(lanes, imaginarySum);
+	imaginary += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+	return i;
+}
+
+bool UseAVX2()
+{
+	static const bool supported(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"));
+	return supported && vectorizationEnabled;
+}
+
+}// namespace
+
+#endif// RESPONSE_KERNEL_AVX2
+
+bool IsVectorized()
+{
+#ifdef RESPONSE_KERNEL_AVX2
+	return UseAVX2();
+#else
+	return false;
+#endif
+}
+
+void SetVectorizationEnabled(const bool& enabled)
+{
+#ifdef RESPONSE_KERNEL_AVX2
+	vectorizationEnabled = enabled;
+#else
+	(void)enabled;
+#endif
+}
+
+void ComputeGain(const double* frequency, double* gain, const std::size_t& count,
+	const double& wavenumberScale, const double& b)
+{
+	std::size_t done(0);
+#ifdef RESPONSE_KERNEL_AVX2
+	if (UseAVX2())
+		done = ComputeGainAVX2(frequency, gain, count, wavenumberScale, b);
+#endif
+
+	// Remaining points (or all of them, if vectorization is not available)
+	ComputeGainScalar(frequency + done, gain + done, count - done, wavenumberScale, b);
+}
+
+void SumPhasors(const double* pathDifference, const double* weight, const std::size_t& count,
+	const double& wavenumber, double& real, double& imaginary)
+{
+	std::size_t done(0);
+#ifdef RESPONSE_KERNEL_AVX2
+	if (UseAVX2())
+		done = SumPhasorsAVX2(pathDifference, weight, count, wavenumber, real, imaginary);
+#endif
+
+	SumPhasorsScalar(pathDifference + done, weight + done, count - done, wavenumber, real, imaginary);
+}
+
+}// namespace ResponseKernel
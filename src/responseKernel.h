@@ -0,0 +1,48 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  responseKernel.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Vectorized evaluation of the reflector gain equations.
+
+#ifndef RESPONSE_KERNEL_H_
+#define RESPONSE_KERNEL_H_
+
+// Standard C++ headers
+#include <cstddef>
+
+namespace ResponseKernel
+{
+
+// Evaluates gain = 20 * log10(sqrt(1 + (k * b)^2 + 2 * k * b * sin(k))) for each frequency,
+// where k = wavenumberScale * frequency (= 4 * pi * a / lambda) and b = log(1 + l / a).
+// Uses AVX2 when the processor supports it, otherwise falls back to a portable scalar loop.
+void ComputeGain(const double* frequency, double* gain, const std::size_t& count,
+	const double& wavenumberScale, const double& b);
+
+// Portable path, exposed separately so it can be used as a reference
+void ComputeGainScalar(const double* frequency, double* gain, const std::size_t& count,
+	const double& wavenumberScale, const double& b);
+
+// Accumulates sum(weight * exp(i * wavenumber * pathDifference)) over count points
+void SumPhasors(const double* pathDifference, const double* weight, const std::size_t& count,
+	const double& wavenumber, double& real, double& imaginary);
+
+void SumPhasorsScalar(const double* pathDifference, const double* weight, const std::size_t& count,
+	const double& wavenumber, double& real, double& imaginary);
+
+bool IsVectorized();
+
+// Lets the scalar path be forced on processors that support AVX2 (for testing); not thread-safe
+void SetVectorizationEnabled(const bool& enabled);
+
+}// namespace ResponseKernel
+
+#endif// RESPONSE_KERNEL_H_
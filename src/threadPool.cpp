@@ -0,0 +1,82 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  threadPool.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Simple pool of worker threads for splitting calculations across cores.
+
+// Local headers
+#include "threadPool.h"
+
+ThreadPool::ThreadPool(const unsigned int& threadCount)
+{
+	unsigned int count(threadCount);
+	if (count == 0)
+		count = std::max(std::thread::hardware_concurrency(), 1U);
+
+	for (unsigned int i = 0; i < count; ++i)
+		threads.emplace_back(&ThreadPool::ThreadEntry, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	jobReadyCondition.notify_all();
+
+	for (auto& t : threads)
+		t.join();
+}
+
+void ThreadPool::AddJob(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.push(std::move(job));
+		++pendingJobCount;
+	}
+	jobReadyCondition.notify_one();
+}
+
+void ThreadPool::WaitForAllJobsComplete()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	jobsCompleteCondition.wait(lock, [this]() { return pendingJobCount == 0; });
+}
+
+void ThreadPool::ThreadEntry()
+{
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			jobReadyCondition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+			if (jobs.empty())
+				return;// Only get here when stopping
+
+			job = std::move(jobs.front());
+			jobs.pop();
+		}
+
+		job();
+
+		bool allComplete;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			allComplete = --pendingJobCount == 0;
+		}
+
+		if (allComplete)
+			jobsCompleteCondition.notify_all();
+	}
+}
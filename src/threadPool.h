@@ -0,0 +1,94 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  threadPool.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Simple pool of worker threads for splitting calculations across cores.
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+// Standard C++ headers
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+class ThreadPool
+{
+public:
+	// Zero threads means "use one thread per core"
+	explicit ThreadPool(const unsigned int& threadCount = 0);
+	~ThreadPool();
+
+	void AddJob(std::function<void()> job);
+	void WaitForAllJobsComplete();
+
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(threads.size()); }
+
+	// Calls function(i) for every i in [0, count), split into blocks across the pool.  Blocks until complete.
+	template<typename Function>
+	void ParallelFor(const std::size_t& count, const Function& function);
+
+	// Calls function(begin, end, blockIndex) for each of blockCount contiguous blocks covering [0, count).
+	// Block boundaries depend only on count and blockCount (not on the number of threads).
+	template<typename Function>
+	void ParallelForBlocks(const std::size_t& count, const std::size_t& blockCount, const Function& function);
+
+private:
+	std::vector<std::thread> threads;
+	std::queue<std::function<void()>> jobs;
+
+	std::mutex mutex;
+	std::condition_variable jobReadyCondition;
+	std::condition_variable jobsCompleteCondition;
+
+	unsigned int pendingJobCount = 0;
+	bool stopping = false;
+
+	void ThreadEntry();
+};
+
+template<typename Function>
+void ThreadPool::ParallelFor(const std::size_t& count, const Function& function)
+{
+	// Several blocks per thread so uneven work still balances reasonably well
+	const std::size_t blockCount(std::min<std::size_t>(count, threads.size() * 4));
+	ParallelForBlocks(count, blockCount, [&function](const std::size_t& begin, const std::size_t& end, const std::size_t&)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+			function(i);
+	});
+}
+
+template<typename Function>
+void ThreadPool::ParallelForBlocks(const std::size_t& count, const std::size_t& blockCount, const Function& function)
+{
+	if (count == 0 || blockCount == 0)
+		return;
+
+	const std::size_t blockSize(count / blockCount);
+	const std::size_t remainder(count % blockCount);
+	std::size_t begin(0);
+	for (std::size_t i = 0; i < blockCount; ++i)
+	{
+		const std::size_t end(begin + blockSize + (i < remainder ? 1 : 0));
+		if (end > begin)
+			AddJob([&function, begin, end, i]() { function(begin, end, i); });
+		begin = end;
+	}
+
+	WaitForAllJobsComplete();
+}
+
+#endif// THREAD_POOL_H_
@@ -0,0 +1,135 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  toleranceAnalysis.cpp
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Monte Carlo analysis of the effect of manufacturing errors on dish performance.
+
+// Local headers
+#include "toleranceAnalysis.h"
+#include "facetedSurface.h"
+#include "focalRayTracer.h"
+#include "facetedResponseCalculator.h"
+#include "threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+ToleranceAnalysis::Results ToleranceAnalysis::Run(const Tolerances& tolerances, const Settings& settings) const
+{
+	const unsigned int frequencyCount(static_cast<unsigned int>(settings.frequency.size()));
+
+	Results results;
+	results.frequency = settings.frequency;
+	results.percentile = settings.percentile;
+
+	const FacetedSurface nominalSurface(info);
+	const auto nominalFocus(FocalRayTracer::Trace(nominalSurface, settings.rayCount, settings.micRadius, settings.seed));
+	results.nominalRmsSpotRadius = nominalFocus.rmsSpotRadius;
+	results.nominalCapturedFraction = nominalFocus.capturedFraction;
+	results.nominalGain.resize(frequencyCount);
+	FacetedResponseCalculator::ComputeResponse(nominalSurface, settings.frequency.data(), results.nominalGain.data(), frequencyCount);
+
+	results.rmsSpotRadius.resize(settings.sampleCount);
+	results.capturedFraction.resize(settings.sampleCount);
+	results.gainLoss.resize(static_cast<std::size_t>(settings.sampleCount) * frequencyCount);
+
+	ThreadPool pool(threadCount);
+	pool.ParallelFor(settings.sampleCount, [this, &tolerances, &settings, &results, &frequencyCount](const std::size_t& i)
+	{
+		std::seed_seq sequence({ static_cast<std::uint32_t>(settings.seed), static_cast<std::uint32_t>(settings.seed >> 32),
+			static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(static_cast<std::uint64_t>(i) >> 32) });
+		std::mt19937_64 generator(sequence);
+
+		// Standard normals by Box-Muller from the same 53-bit uniforms as FocalRayTracer, since std::normal_distribution
+		// (like std::uniform_real_distribution) gives different samples under different standard libraries
+		auto uniform([&generator]()
+		{
+			return static_cast<double>(generator() >> 11) * 0x1.0p-53;
+		});
+
+		bool haveSpare(false);
+		double spare(0.0);
+		auto normal([&uniform, &haveSpare, &spare]()
+		{
+			if (haveSpare)
+			{
+				haveSpare = false;
+				return spare;
+			}
+
+			const double radius(sqrt(-2.0 * log(1.0 - uniform())));// 1 - u is in (0, 1], so the log is finite
+			const double angle(2.0 * M_PI * uniform());
+			spare = radius * sin(angle);
+			haveSpare = true;
+			return radius * cos(angle);
+		});
+
+		std::vector<FacetedSurface::GoreError> errors(info.facetCount);
+		for (auto& error : errors)
+		{
+			error.radialOffset = tolerances.cutError * normal();
+			error.scale = 1.0 + tolerances.scaleError * normal();
+			error.tilt = tolerances.angleError * M_PI / 180.0 * normal();
+		}
+
+		const FacetedSurface surface(info, errors);
+		const auto focus(FocalRayTracer::Trace(surface, settings.rayCount, settings.micRadius, settings.seed));
+		results.rmsSpotRadius[i] = focus.rmsSpotRadius;
+		results.capturedFraction[i] = focus.capturedFraction;
+
+		double* gainLoss(results.gainLoss.data() + i * frequencyCount);
+		FacetedResponseCalculator::ComputeResponse(surface, settings.frequency.data(), gainLoss, frequencyCount);
+		for (unsigned int j = 0; j < frequencyCount; ++j)
+			gainLoss[j] = results.nominalGain[j] - gainLoss[j];
+	});
+
+	results.rmsSpotRadiusBand = ComputeBand(results.rmsSpotRadius, settings.percentile);
+	results.capturedFractionBand = ComputeBand(results.capturedFraction, settings.percentile);
+
+	std::vector<double> frequencyLoss(settings.sampleCount);
+	for (unsigned int j = 0; j < frequencyCount; ++j)
+	{
+		for (unsigned int i = 0; i < settings.sampleCount; ++i)
+			frequencyLoss[i] = results.gainLoss[static_cast<std::size_t>(i) * frequencyCount + j];
+
+		const auto band(ComputeBand(frequencyLoss, settings.percentile));
+		results.gainLossBand.insert(results.gainLossBand.end(), band.begin(), band.end());
+	}
+
+	return results;
+}
+
+std::vector<double> ToleranceAnalysis::ComputeBand(std::vector<double> values, const std::vector<double>& percentiles)
+{
+	std::sort(values.begin(), values.end());
+	std::vector<double> band(percentiles.size());
+	for (unsigned int i = 0; i < percentiles.size(); ++i)
+		band[i] = ComputePercentile(values, percentiles[i]);
+	return band;
+}
+
+double ToleranceAnalysis::ComputePercentile(const std::vector<double>& sortedValues, const double& percentile)
+{
+	if (sortedValues.empty())
+		return 0.0;
+
+	assert(percentile >= 0.0 && percentile <= 100.0);
+	const double position(0.01 * percentile * (sortedValues.size() - 1));
+	const auto lower(static_cast<std::size_t>(position));
+	if (lower + 1 >= sortedValues.size())
+		return sortedValues.back();
+
+	const double fraction(position - lower);
+	return sortedValues[lower] + fraction * (sortedValues[lower + 1] - sortedValues[lower]);
+}
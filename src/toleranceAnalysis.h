@@ -0,0 +1,86 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  toleranceAnalysis.h
+// Date:  10/15/2026
+// Auth:  agent
+// Desc:  Monte Carlo analysis of the effect of manufacturing errors on dish performance.
+
+#ifndef TOLERANCE_ANALYSIS_H_
+#define TOLERANCE_ANALYSIS_H_
+
+// Local headers
+#include "parabolaCalculator.h"
+
+// Standard C++ headers
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class ToleranceAnalysis
+{
+public:
+	explicit ToleranceAnalysis(const ParabolaCalculator::ParabolaInfo& _info) : info(_info) {}
+
+	// Standard deviations of normally distributed errors, drawn independently for each gore
+	struct Tolerances
+	{
+		double cutError = 0.0;// [in] length error at the gore tip, which moves the whole gore along its center line
+		double scaleError = 0.0;// [-] fractional print scale error
+		double angleError = 0.0;// [deg] assembly tilt of the gore about the apex
+	};
+
+	struct Settings
+	{
+		unsigned int sampleCount = 1000;
+		std::size_t rayCount = 20000;// per sample
+		double micRadius = 0.25;// [in]
+		std::vector<double> frequency = { 1000.0, 2000.0, 5000.0, 10000.0, 20000.0 };// [Hz]
+		std::vector<double> percentile = { 5.0, 50.0, 95.0 };// [%]
+		std::uint64_t seed = 0;
+	};
+
+	// Gain loss is relative to the same faceted design built without errors.  Per-sample values are stored in
+	// sample order, with gain losses row-major (one row of frequency.size() values per sample).  Bands hold one value
+	// per requested percentile (gain loss bands are row-major, one row of percentile.size() values per frequency).
+	struct Results
+	{
+		std::vector<double> frequency;// [Hz]
+		std::vector<double> percentile;// [%]
+
+		double nominalRmsSpotRadius;// [in]
+		double nominalCapturedFraction;// [-]
+		std::vector<double> nominalGain;// [dB]
+
+		std::vector<double> rmsSpotRadius;// [in]
+		std::vector<double> capturedFraction;// [-]
+		std::vector<double> gainLoss;// [dB]
+
+		std::vector<double> rmsSpotRadiusBand;// [in]
+		std::vector<double> capturedFractionBand;// [-]
+		std::vector<double> gainLossBand;// [dB]
+	};
+
+	// Samples are generated from seed and the sample index, and every sample traces the same rays, so results don't
+	// depend on the number of threads and differences between samples are due only to the manufacturing errors
+	Results Run(const Tolerances& tolerances, const Settings& settings) const;
+
+	// Zero threads means "use one thread per core"
+	void SetThreadCount(const unsigned int& count) { threadCount = count; }
+
+private:
+	const ParabolaCalculator::ParabolaInfo info;
+	unsigned int threadCount = 0;
+
+	// Linear interpolation between order statistics
+	static double ComputePercentile(const std::vector<double>& sortedValues, const double& percentile);
+	static std::vector<double> ComputeBand(std::vector<double> values, const std::vector<double>& percentiles);
+};
+
+#endif// TOLERANCE_ANALYSIS_H_
@@ -0,0 +1,107 @@
+/*===================================================================================
+                                 Parabolic Design App
+                          Copyright Kerry R. Loux 2021
+
+                   This code is licensed under the GPLv2 License
+                     (http://opensource.org/licenses/GPL-2.0).
+
+===================================================================================*/
+
+// File:  responseKernelTest.cpp
+// Date:  10/16/2026
+// Auth:  agent
+// Desc:  Checks ResponseKernel::ComputeGain (vectorized and scalar paths) against the original response expression
+//        over a grid of designs and frequencies.  Run with "make test"; returns non-zero on failure.
+
+// Local headers
+#include "responseKernel.h"
+
+// Standard C++ headers
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+namespace
+{
+
+const double speedOfSound(13503.937008);// [in/sec] same as ParabolaCalculator
+
+// The gain expression as originally written in ParabolaCalculator::GetResponse
+double ReferenceGain(const double& diameter, const double& focusPosition, const double& frequency)
+{
+	const double depthToFocusRatio(diameter * diameter / (16.0 * focusPosition) / focusPosition);// [-]
+	const double wavelength(speedOfSound / frequency);// [in]
+	const double focusToWavelengthRatio(focusPosition / wavelength);// [-]
+	const double b(log(1.0 + depthToFocusRatio));// [-]
+	const double pressureFactor(sqrt(1.0 + pow(4.0 * M_PI * focusToWavelengthRatio * b, 2) + 8.0 * M_PI * focusToWavelengthRatio * b * sin(4.0 * M_PI * focusToWavelengthRatio)));// [-]
+	return 20.0 * log10(pressureFactor);
+}
+
+// Compares in terms of the squared pressure factor, relative to the size of its terms, since the gain in dB is
+// ill-conditioned near the nulls (where the terms nearly cancel)
+unsigned int CheckDesign(const double& diameter, const double& focusPosition, const std::vector<double>& frequency, double& worstError)
+{
+	const double b(log(1.0 + diameter * diameter / (16.0 * focusPosition) / focusPosition));
+	const double wavenumberScale(4.0 * M_PI * focusPosition / speedOfSound);// [sec]
+
+	std::vector<double> gain(frequency.size());
+	ResponseKernel::ComputeGain(frequency.data(), gain.data(), frequency.size(), wavenumberScale, b);
+
+	const double tolerance(1.0e-12);
+	unsigned int failures(0);
+	for (unsigned int i = 0; i < frequency.size(); ++i)
+	{
+		const double x(wavenumberScale * frequency[i] * b);
+		const double scale(1.0 + x * x + 2.0 * fabs(x));
+		const double error(fabs(pow(10.0, 0.1 * gain[i]) - pow(10.0, 0.1 * ReferenceGain(diameter, focusPosition, frequency[i]))) / scale);
+		worstError = std::max(worstError, error);
+		if (!(error <= tolerance))
+		{
+			if (failures == 0)
+				printf("  FAIL:  D = %g in, a = %g in, f = %g Hz:  %.17g dB (expected %.17g dB)\n", diameter, focusPosition,
+					frequency[i], gain[i], ReferenceGain(diameter, focusPosition, frequency[i]));
+			++failures;
+		}
+	}
+
+	return failures;
+}
+
+unsigned int CheckAllDesigns(const char* label)
+{
+	// Odd count exercises the scalar tail after the vectorized blocks
+	std::vector<double> frequency;
+	for (double f = 20.0; f <= 40000.0; f *= 1.0071)
+		frequency.push_back(f);
+
+	unsigned int failures(0);
+	double worstError(0.0);
+	for (double diameter = 6.0; diameter <= 120.0; diameter *= 1.5)
+	{
+		for (double focusRatio = 0.1; focusRatio <= 1.5; focusRatio += 0.1)
+			failures += CheckDesign(diameter, diameter * focusRatio, frequency, worstError);
+	}
+
+	printf("%s:  worst relative error %.3g, %u failures\n", label, worstError, failures);
+	return failures;
+}
+
+}// namespace
+
+int main()
+{
+	unsigned int failures(0);
+	printf("Vectorized path %s\n", ResponseKernel::IsVectorized() ? "available" : "not available");
+	failures += CheckAllDesigns("Default path");
+
+	ResponseKernel::SetVectorizationEnabled(false);
+	if (ResponseKernel::IsVectorized())
+	{
+		printf("FAIL:  scalar path could not be forced\n");
+		++failures;
+	}
+	failures += CheckAllDesigns("Forced scalar path");
+
+	return failures == 0 ? 0 : 1;
+}